@@ -4,7 +4,9 @@ DEL /F /S /Q "*.opensdf"
 DEL /F /S /Q "*.db"
 RMDIR /S /Q "RandomLibraryUnitTest\Debug"
 RMDIR /S /Q "RandomLibraryUnitTest\Release"
+RMDIR /S /Q "RandomLibraryUnitTest\Instrumented"
 RMDIR /S /Q "Debug"
 RMDIR /S /Q "Release"
+RMDIR /S /Q "Instrumented"
 RMDIR /S /Q "ipch"
 RMDIR /S /Q ".vs"
\ No newline at end of file
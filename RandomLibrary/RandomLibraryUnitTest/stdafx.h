@@ -14,4 +14,13 @@
 
 #include <Singleton.h>
 #include <MyAssert.h>
-#include <Random.h>
\ No newline at end of file
+#include <Random.h>
+#include <Noise.h>
+#include <Sampler.h>
+#include <IdGenerator.h>
+#include <RandomView.h>
+#include <InverseCdf.h>
+#include <Permutation.h>
+#include <WeightedSampler.h>
+#include <RandomArray.h>
+#include <StreamAllocator.h>
\ No newline at end of file
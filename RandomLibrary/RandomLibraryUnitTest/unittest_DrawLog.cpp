@@ -0,0 +1,223 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <chrono>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace RandomLibraryUnitTest
+{
+	TEST_CLASS(UnitTest_DrawLog)
+	{
+	public:
+
+		TEST_METHOD(TestDrawLogReplay)
+		{
+			// a replayed run should see exactly the recorded results
+			// even with a different seed
+
+			const char *filename = "unittest_drawlog_replay.log";
+			int loopnum = 1000;
+			std::vector<float> expected;
+
+			{
+				Random random(1234);
+				DrawLog log;
+
+				Assert::IsTrue(log.Create(filename));
+				random.SetDrawLog(&log);
+
+				for (int i = 0; i < loopnum; ++i)
+				{
+					expected.push_back(static_cast<float>(random.RangeInt(-i, i)));
+					expected.push_back(random.RangeFloat(0.0f, 5.0f));
+					expected.push_back(random.NormalRange(2.0f, 1.0f, (i % 2) == 0));
+					expected.push_back(random.NormalRangeMinMax(-3.0f, 3.0f));
+					expected.push_back(random.CoinToss(0.3f) ? 1.0f : 0.0f);
+				}
+
+				Assert::IsTrue(log.GetCount() == expected.size());
+			}
+
+			Random random(4321);
+			DrawLog log;
+
+			Assert::IsTrue(log.Open(filename));
+			Assert::IsTrue(log.GetCount() == expected.size());
+
+			// arguments are stored with each draw
+
+			DrawRecord record;
+			Assert::IsTrue(log.Read(5, record));
+			Assert::AreEqual(static_cast<int>(RANDOM_API_RANGE_INT), static_cast<int>(record.api));
+			Assert::AreEqual(-1, record.args[0].i);
+			Assert::AreEqual(1, record.args[1].i);
+
+			random.SetDrawLog(&log);
+
+			std::vector<float> replayed;
+
+			for (int i = 0; i < loopnum; ++i)
+			{
+				replayed.push_back(static_cast<float>(random.RangeInt(-i, i)));
+				replayed.push_back(random.RangeFloat(0.0f, 5.0f));
+				replayed.push_back(random.NormalRange(2.0f, 1.0f, (i % 2) == 0));
+				replayed.push_back(random.NormalRangeMinMax(-3.0f, 3.0f));
+				replayed.push_back(random.CoinToss(0.3f) ? 1.0f : 0.0f);
+			}
+
+			Assert::IsTrue(expected == replayed);
+			Assert::IsTrue(log.GetPosition() == log.GetCount());
+
+			log.Close();
+			DeleteFileA(filename);
+		}
+
+		TEST_METHOD(TestDrawLogUnitReplay)
+		{
+			// numbers built from raw words are logged as their words, so they replay too
+
+			const char *filename = "unittest_drawlog_unit.log";
+			int loopnum = 1000;
+			std::vector<double> expected;
+			float floats[8];
+
+			{
+				Random random(1234);
+				DrawLog log;
+
+				Assert::IsTrue(log.Create(filename));
+				random.SetDrawLog(&log);
+
+				for (int i = 0; i < loopnum; ++i)
+				{
+					expected.push_back(random.UnitFloat(RANDOM_OPEN_OPEN, (i % 2) == 0));
+					expected.push_back(random.UnitDouble(RANDOM_CLOSED_OPEN, (i % 3) == 0));
+					expected.push_back(HalfToFloat(random.RangeHalf(-1.0f, 1.0f)));
+					random.FillUnitFloat(floats, 8);
+					expected.insert(expected.end(), floats, floats + 8);
+				}
+			}
+
+			// recording takes the same words as a run without a log
+
+			{
+				Random random(1234);
+				std::vector<double> unlogged;
+
+				for (int i = 0; i < loopnum; ++i)
+				{
+					unlogged.push_back(random.UnitFloat(RANDOM_OPEN_OPEN, (i % 2) == 0));
+					unlogged.push_back(random.UnitDouble(RANDOM_CLOSED_OPEN, (i % 3) == 0));
+					unlogged.push_back(HalfToFloat(random.RangeHalf(-1.0f, 1.0f)));
+					random.FillUnitFloat(floats, 8);
+					unlogged.insert(unlogged.end(), floats, floats + 8);
+				}
+
+				Assert::IsTrue(expected == unlogged);
+			}
+
+			Random random(4321);
+			DrawLog log;
+			std::vector<double> replayed;
+
+			Assert::IsTrue(log.Open(filename));
+			random.SetDrawLog(&log);
+
+			for (int i = 0; i < loopnum; ++i)
+			{
+				replayed.push_back(random.UnitFloat(RANDOM_OPEN_OPEN, (i % 2) == 0));
+				replayed.push_back(random.UnitDouble(RANDOM_CLOSED_OPEN, (i % 3) == 0));
+				replayed.push_back(HalfToFloat(random.RangeHalf(-1.0f, 1.0f)));
+				random.FillUnitFloat(floats, 8);
+				replayed.insert(replayed.end(), floats, floats + 8);
+			}
+
+			Assert::IsTrue(expected == replayed);
+			Assert::IsTrue(log.GetPosition() == log.GetCount());
+
+			log.Close();
+			DeleteFileA(filename);
+		}
+
+		TEST_METHOD(TestDrawLogLarge)
+		{
+			// a log bigger than one mapped window, log record/replay throughput
+
+			typedef std::chrono::high_resolution_clock Clock;
+
+			const char *filename = "unittest_drawlog_large.log";
+			int loopnum = 2000000;
+			long long checksum_record = 0;
+			long long checksum_replay = 0;
+
+			Clock::time_point start = Clock::now();
+			{
+				Random random(99);
+				DrawLog log;
+
+				Assert::IsTrue(log.Create(filename));
+				random.SetDrawLog(&log);
+
+				for (int i = 0; i < loopnum; ++i)
+					checksum_record += random.RangeInt();
+			}
+			double record = std::chrono::duration<double>(Clock::now() - start).count();
+
+			start = Clock::now();
+			{
+				Random random;
+				DrawLog log;
+
+				Assert::IsTrue(log.Open(filename));
+				Assert::IsTrue(log.GetCount() == static_cast<unsigned long long>(loopnum));
+				random.SetDrawLog(&log);
+
+				for (int i = 0; i < loopnum; ++i)
+					checksum_replay += random.RangeInt();
+			}
+			double replay = std::chrono::duration<double>(Clock::now() - start).count();
+
+			char output[128];
+			sprintf_s(output, "record: %.1f M draws/s\nreplay: %.1f M draws/s\n",
+				loopnum / record * 1e-6, loopnum / replay * 1e-6);
+			Logger::WriteMessage(output);
+
+			Assert::IsTrue(checksum_record == checksum_replay);
+
+			DeleteFileA(filename);
+		}
+
+		TEST_METHOD(TestDrawLogRecover)
+		{
+			// a log that was never closed (e.g. crash) can still be replayed
+
+			const char *filename = "unittest_drawlog_recover.log";
+			Random random(7);
+			DrawLog writer;
+			std::vector<int> expected;
+
+			Assert::IsTrue(writer.Create(filename));
+			random.SetDrawLog(&writer);
+
+			for (int i = 0; i < 100; ++i)
+				expected.push_back(random.RangeInt());
+
+			DrawLog reader;
+			Assert::IsTrue(reader.Open(filename));
+			Assert::IsTrue(reader.GetCount() == expected.size());
+
+			for (size_t i = 0; i < expected.size(); ++i)
+			{
+				DrawRecord record;
+				Assert::IsTrue(reader.Next(record));
+				Assert::AreEqual(expected[i], record.result.i);
+			}
+
+			reader.Close();
+			writer.Close();
+			DeleteFileA(filename);
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,185 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <chrono>
+#include <cstring>
+#include <set>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace RandomLibraryUnitTest
+{
+	TEST_CLASS(UnitTest_IdGenerator)
+	{
+	public:
+
+		TEST_METHOD(TestUuidFormat)
+		{
+			// 8-4-4-4-12 lowercase hex, version 4, variant 1
+
+			Random random(1234);
+			IdGenerator ids(random);
+			char uuid[UUID_STRING_LENGTH + 1];
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				ids.Uuid(uuid);
+
+				Assert::AreEqual(static_cast<size_t>(UUID_STRING_LENGTH), strlen(uuid));
+
+				for (int j = 0; j < UUID_STRING_LENGTH; ++j)
+				{
+					if ((j == 8) || (j == 13) || (j == 18) || (j == 23))
+						Assert::AreEqual('-', uuid[j]);
+					else
+						Assert::IsTrue(strchr("0123456789abcdef", uuid[j]) != NULL);
+				}
+
+				Assert::AreEqual('4', uuid[14]);
+				Assert::IsTrue(strchr("89ab", uuid[19]) != NULL);
+			}
+		}
+
+		TEST_METHOD(TestTokenAlphabets)
+		{
+			// every character is from the encoding's alphabet, every value appears
+
+			Random random(99);
+			IdGenerator ids(random);
+			const int length = 1000;
+			char token[length + 1];
+
+			const char *alphabets[3] =
+			{
+				"0123456789abcdef",
+				"ABCDEFGHIJKLMNOPQRSTUVWXYZ234567",
+				"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+			};
+
+			for (int k = 0; k < 3; ++k)
+			{
+				if (k == 0)
+					ids.Hex(token, length);
+				else if (k == 1)
+					ids.Base32(token, length);
+				else
+					ids.Base62(token, length);
+
+				Assert::AreEqual(static_cast<size_t>(length), strlen(token));
+
+				std::set<char> seen(token, token + length);
+
+				for (int i = 0; i < length; ++i)
+					Assert::IsTrue(strchr(alphabets[k], token[i]) != NULL);
+
+				Assert::AreEqual(strlen(alphabets[k]), seen.size());
+			}
+		}
+
+		TEST_METHOD(TestIdUnique)
+		{
+			Random random(7);
+			IdGenerator ids(random);
+			std::set<unsigned long long> seen;
+			int loopnum = 100000;
+
+			for (int i = 0; i < loopnum; ++i)
+				seen.insert(ids.Id64());
+
+			Assert::AreEqual(static_cast<size_t>(loopnum), seen.size());
+
+			UInt128 a = ids.Id128();
+			UInt128 b = ids.Id128();
+			Assert::IsTrue((a.high != b.high) || (a.low != b.low));
+		}
+
+		TEST_METHOD(TestIdDeterministic)
+		{
+			// same seed gives the same ids, bulk calls match single calls
+
+			const int count = 100;
+			const int length = 22;
+
+			Random random_single(42);
+			Random random_bulk(42);
+			IdGenerator single(random_single);
+			IdGenerator bulk(random_bulk);
+
+			std::vector<char> uuids(count * UUID_STRING_LENGTH);
+			std::vector<char> tokens(count * length);
+			std::vector<unsigned long long> values(count);
+			char buffer[UUID_STRING_LENGTH + 1];
+
+			bulk.Uuids(&uuids[0], count);
+
+			for (int i = 0; i < count; ++i)
+			{
+				single.Uuid(buffer);
+				Assert::IsTrue(memcmp(buffer, &uuids[i * UUID_STRING_LENGTH], UUID_STRING_LENGTH) == 0);
+			}
+
+			bulk.Base62s(&tokens[0], count, length);
+
+			for (int i = 0; i < count; ++i)
+			{
+				single.Base62(buffer, length);
+				Assert::IsTrue(memcmp(buffer, &tokens[i * length], length) == 0);
+			}
+
+			bulk.Hexes(&tokens[0], count, length);
+
+			for (int i = 0; i < count; ++i)
+			{
+				single.Hex(buffer, length);
+				Assert::IsTrue(memcmp(buffer, &tokens[i * length], length) == 0);
+			}
+
+			bulk.Id64s(&values[0], count);
+
+			for (int i = 0; i < count; ++i)
+				Assert::IsTrue(single.Id64() == values[i]);
+		}
+
+		TEST_METHOD(TestIdThroughput)
+		{
+			// log ids per second of each encoding
+
+			typedef std::chrono::high_resolution_clock Clock;
+
+			Random random(5);
+			IdGenerator ids(random);
+			const int count = 200000;
+			const int length = 22;
+			std::vector<char> strings(count * UUID_STRING_LENGTH);
+			std::vector<unsigned long long> values(count);
+			double seconds[5];
+
+			for (int k = 0; k < 5; ++k)
+			{
+				Clock::time_point start = Clock::now();
+
+				if (k == 0)
+					ids.Uuids(&strings[0], count);
+				else if (k == 1)
+					ids.Hexes(&strings[0], count, length);
+				else if (k == 2)
+					ids.Base32s(&strings[0], count, length);
+				else if (k == 3)
+					ids.Base62s(&strings[0], count, length);
+				else
+					ids.Id64s(&values[0], count);
+
+				seconds[k] = std::chrono::duration<double>(Clock::now() - start).count();
+			}
+
+			char output[256];
+			sprintf_s(output, "uuid: %.1f M ids/s\nhex%d: %.1f M ids/s\nbase32-%d: %.1f M ids/s\nbase62-%d: %.1f M ids/s\nid64: %.1f M ids/s\n",
+				count / seconds[0] * 1e-6, length, count / seconds[1] * 1e-6, length, count / seconds[2] * 1e-6,
+				length, count / seconds[3] * 1e-6, count / seconds[4] * 1e-6);
+			Logger::WriteMessage(output);
+
+			Assert::IsTrue(values[0] != values[1]);
+		}
+	};
+}
@@ -0,0 +1,143 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace RandomLibraryUnitTest
+{
+	TEST_CLASS(UnitTest_InverseCdf)
+	{
+	public:
+
+		TEST_METHOD(TestInverseCdfTriangle)
+		{
+			// pdf(x) = 2x on [0, 1], CDF is x^2 and mean is 2/3
+
+			InverseCdf table;
+			Assert::IsTrue(table.Build([](float x) { return 2.0f * x; }, 0.0f, 1.0f));
+
+			Assert::AreEqual(0.5f, table.Quantile(0.25f), 0.001f);
+			Assert::AreEqual(0.9f, table.Quantile(0.81f), 0.001f);
+
+			Random random(1234);
+			int loopnum = 100000;
+			double sum = 0.0;
+			int below_half = 0;
+
+			for (int i = 0; i < loopnum; ++i)
+			{
+				float value = table.Sample(random);
+
+				Assert::IsTrue((value >= 0.0f) && (value <= 1.0f));
+
+				sum += value;
+
+				if (value < 0.5f)
+					++below_half;
+			}
+
+			Assert::AreEqual(2.0 / 3.0, sum / loopnum, 0.01);
+			Assert::AreEqual(0.25, static_cast<double>(below_half) / loopnum, 0.01);
+		}
+
+		TEST_METHOD(TestInverseCdfTabulated)
+		{
+			// empirical histogram with an empty gap, the gap is never sampled
+
+			float x[6] = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+			float pdf[6] = { 1.0f, 1.0f, 0.0f, 0.0f, 3.0f, 3.0f };
+			InverseCdf table;
+
+			Assert::IsTrue(table.Build(x, pdf, 6, 4));
+
+			Random random(99);
+			int loopnum = 100000;
+			int high = 0;
+
+			for (int i = 0; i < loopnum; ++i)
+			{
+				float value = table.Sample(random);
+
+				Assert::IsTrue((value <= 2.0f) || (value >= 3.0f));
+
+				if (value >= 3.0f)
+					++high;
+			}
+
+			// masses are 1 + 0.5 for 0~2 and 1.5 + 3 for 3~5
+
+			Assert::AreEqual(0.75, static_cast<double>(high) / loopnum, 0.01);
+
+			// not a distribution
+
+			float descending[2] = { 1.0f, 0.0f };
+			float zero[2] = { 0.0f, 0.0f };
+			float negative[2] = { -1.0f, 1.0f };
+
+			Assert::IsFalse(table.Build(descending, pdf, 2));
+			Assert::IsFalse(table.Build(x, zero, 2));
+			Assert::IsFalse(table.Build(x, negative, 2));
+			Assert::IsFalse(table.IsBuilt());
+		}
+
+		TEST_METHOD(TestInverseCdfFill)
+		{
+			// bulk fill gives the same values as Sample
+
+			InverseCdf table;
+			Assert::IsTrue(table.Build([](float x) { return std::exp(-x); }, 0.0f, 10.0f, 256, 64));
+
+			const int count = 1000;
+			Random random_single(7);
+			Random random_bulk(7);
+			std::vector<float> values(count);
+
+			table.Fill(random_bulk, &values[0], count);
+
+			for (int i = 0; i < count; ++i)
+				Assert::AreEqual(table.Sample(random_single), values[i]);
+		}
+
+		TEST_METHOD(TestInverseCdfThroughput)
+		{
+			// log build time, memory and samples per second for several table sizes
+
+			typedef std::chrono::high_resolution_clock Clock;
+
+			int sizes[4] = { 16, 256, 4096, 65536 };
+			const int count = 1 << 20;
+			std::vector<float> values(count);
+
+			for (int k = 0; k < 4; ++k)
+			{
+				InverseCdf table;
+
+				Clock::time_point start = Clock::now();
+				Assert::IsTrue(table.Build([](float x) { return std::exp(-0.5f * x * x); }, -4.0f, 4.0f, sizes[k]));
+				double build = std::chrono::duration<double>(Clock::now() - start).count();
+
+				Random random(5);
+
+				start = Clock::now();
+				table.Fill(random, &values[0], count);
+				double sample = std::chrono::duration<double>(Clock::now() - start).count();
+
+				double sum = 0.0;
+
+				for (int i = 0; i < count; ++i)
+					sum += values[i];
+
+				char output[256];
+				sprintf_s(output, "%d points: build %.1f us, %u bytes, %.1f M samples/s (mean %.3f)\n",
+					sizes[k], build * 1e6, static_cast<unsigned>(table.GetMemory()), count / sample * 1e-6, sum / count);
+				Logger::WriteMessage(output);
+
+				Assert::AreEqual(0.0, sum / count, 0.01);
+			}
+		}
+	};
+}
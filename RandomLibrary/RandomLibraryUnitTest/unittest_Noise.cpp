@@ -0,0 +1,221 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <chrono>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace RandomLibraryUnitTest
+{
+	TEST_CLASS(UnitTest_Noise)
+	{
+	public:
+
+		TEST_METHOD(TestNoiseSeed)
+		{
+			// same seed should build the same noise, different seed should not
+
+			Random random1(1234);
+			Random random2(1234);
+			Random random3(4321);
+			Noise noise1(random1);
+			Noise noise2(random2);
+			Noise noise3(random3);
+			int num_different = 0;
+
+			for (int i = 0; i < 100; ++i)
+			{
+				float x = i * 0.37f;
+				float y = i * 0.71f;
+
+				Assert::AreEqual(noise1.Perlin2D(x, y), noise2.Perlin2D(x, y));
+				Assert::AreEqual(noise1.Simplex3D(x, y, 0.5f), noise2.Simplex3D(x, y, 0.5f));
+
+				if (noise1.Perlin2D(x, y) != noise3.Perlin2D(x, y))
+					++num_different;
+			}
+
+			Assert::IsTrue(num_different > 50);
+		}
+
+		TEST_METHOD(TestNoiseRange)
+		{
+			// every noise should stay roughly within [-1, 1]
+
+			Random random;
+			Noise noise(random);
+			float limit = 1.1f;
+			bool testresult = true;
+
+			for (int i = 0; i < 10000; ++i)
+			{
+				float x = random.RangeFloat(-100.0f, 100.0f);
+				float y = random.RangeFloat(-100.0f, 100.0f);
+				float z = random.RangeFloat(-100.0f, 100.0f);
+				float w = random.RangeFloat(-100.0f, 100.0f);
+
+				float values[] = {
+					noise.Value1D(x), noise.Value2D(x, y), noise.Value3D(x, y, z),
+					noise.Perlin1D(x), noise.Perlin2D(x, y), noise.Perlin3D(x, y, z), noise.Perlin4D(x, y, z, w),
+					noise.Simplex1D(x), noise.Simplex2D(x, y), noise.Simplex3D(x, y, z), noise.Simplex4D(x, y, z, w),
+					noise.Fractal2D(x, y), noise.Fractal3D(x, y, z, NOISE_SIMPLEX)
+				};
+
+				for (float value : values)
+				{
+					if (std::abs(value) > limit)
+						testresult = false;
+				}
+			}
+
+			Assert::IsTrue(testresult);
+		}
+
+		TEST_METHOD(TestPerlinLattice)
+		{
+			// gradient noise is zero on integer lattice points
+
+			Random random;
+			Noise noise(random);
+
+			for (int i = -10; i < 10; ++i)
+			{
+				float p = static_cast<float>(i);
+
+				Assert::IsTrue(std::abs(noise.Perlin1D(p)) < 0.0001f);
+				Assert::IsTrue(std::abs(noise.Perlin2D(p, p + 3.0f)) < 0.0001f);
+				Assert::IsTrue(std::abs(noise.Perlin3D(p, -p, p * 2.0f)) < 0.0001f);
+				Assert::IsTrue(std::abs(noise.Perlin4D(p, p, -p, 7.0f)) < 0.0001f);
+				Assert::IsTrue(std::abs(noise.Simplex1D(p)) < 0.0001f);
+			}
+		}
+
+		TEST_METHOD(TestPerlinGrid)
+		{
+			// grid evaluation should match the scalar functions
+
+			Random random;
+			Noise noise(random);
+			int width = 37;
+			int height = 5;
+			float x = -3.3f;
+			float y = -1.7f;
+			float z = 2.9f;
+			float step = 0.13f;
+			std::vector<float> grid2(width * height);
+			std::vector<float> grid3(width * height);
+			bool testresult = true;
+
+			noise.Perlin2DGrid(grid2.data(), width, height, x, y, step);
+			noise.Perlin3DGrid(grid3.data(), width, height, x, y, z, step);
+
+			for (int row = 0; row < height; ++row)
+			{
+				for (int col = 0; col < width; ++col)
+				{
+					float px = x + col * step;
+					float py = y + row * step;
+
+					if (std::abs(grid2[row * width + col] - noise.Perlin2D(px, py)) > 0.00001f)
+						testresult = false;
+					if (std::abs(grid3[row * width + col] - noise.Perlin3D(px, py, z)) > 0.00001f)
+						testresult = false;
+				}
+			}
+
+			Assert::IsTrue(testresult);
+		}
+
+		TEST_METHOD(TestFractalGrid)
+		{
+			Random random;
+			Noise noise(random);
+			int width = 300;
+			int height = 3;
+			float step = 0.05f;
+			std::vector<float> grid(width * height);
+			bool testresult = true;
+
+			noise.Fractal2DGrid(grid.data(), width, height, 1.5f, 2.5f, step, 5);
+
+			for (int row = 0; row < height; ++row)
+			{
+				for (int col = 0; col < width; ++col)
+				{
+					float value = noise.Fractal2D(1.5f + col * step, 2.5f + row * step, NOISE_PERLIN, 5);
+
+					if (std::abs(grid[row * width + col] - value) > 0.0001f)
+						testresult = false;
+				}
+			}
+
+			Assert::IsTrue(testresult);
+		}
+
+		TEST_METHOD(TestNoiseThroughput)
+		{
+			// log samples per second of grid evaluation against scalar loops
+
+			typedef std::chrono::high_resolution_clock Clock;
+
+			Random random;
+			Noise noise(random);
+			int size = 512;
+			int passes = 8;
+			std::vector<float> grid(size * size);
+			float checksum = 0.0f;
+
+			Clock::time_point start = Clock::now();
+			for (int pass = 0; pass < passes; ++pass)
+			{
+				for (int row = 0; row < size; ++row)
+				{
+					for (int col = 0; col < size; ++col)
+						grid[row * size + col] = noise.Perlin2D(col * 0.01f, row * 0.01f + pass);
+				}
+				checksum += grid[pass];
+			}
+			double scalar2d = std::chrono::duration<double>(Clock::now() - start).count();
+
+			start = Clock::now();
+			for (int pass = 0; pass < passes; ++pass)
+			{
+				noise.Perlin2DGrid(grid.data(), size, size, 0.0f, static_cast<float>(pass), 0.01f);
+				checksum += grid[pass];
+			}
+			double grid2d = std::chrono::duration<double>(Clock::now() - start).count();
+
+			start = Clock::now();
+			for (int pass = 0; pass < passes; ++pass)
+			{
+				for (int row = 0; row < size; ++row)
+				{
+					for (int col = 0; col < size; ++col)
+						grid[row * size + col] = noise.Perlin3D(col * 0.01f, row * 0.01f, pass * 0.1f);
+				}
+				checksum += grid[pass];
+			}
+			double scalar3d = std::chrono::duration<double>(Clock::now() - start).count();
+
+			start = Clock::now();
+			for (int pass = 0; pass < passes; ++pass)
+			{
+				noise.Perlin3DGrid(grid.data(), size, size, 0.0f, 0.0f, pass * 0.1f, 0.01f);
+				checksum += grid[pass];
+			}
+			double grid3d = std::chrono::duration<double>(Clock::now() - start).count();
+
+			double samples = static_cast<double>(size) * size * passes;
+
+			char output[256];
+			sprintf_s(output, "Perlin2D scalar: %.1f M samples/s\nPerlin2D grid:   %.1f M samples/s\n"
+				"Perlin3D scalar: %.1f M samples/s\nPerlin3D grid:   %.1f M samples/s\n(checksum %.3f)\n",
+				samples / scalar2d * 1e-6, samples / grid2d * 1e-6,
+				samples / scalar3d * 1e-6, samples / grid3d * 1e-6, checksum);
+			Logger::WriteMessage(output);
+
+			Assert::IsTrue(grid2d > 0.0 && grid3d > 0.0);
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace RandomLibraryUnitTest
+{
+	TEST_CLASS(UnitTest_Permutation)
+	{
+	public:
+
+		TEST_METHOD(TestPermutationBijective)
+		{
+			// every element is hit exactly once, Unmap undoes Map
+
+			unsigned long long sizes[6] = { 1, 2, 3, 7, 1000, 65537 };
+			Random random(1234);
+
+			for (int k = 0; k < 6; ++k)
+			{
+				Permutation permutation(random, sizes[k]);
+				std::vector<bool> seen(static_cast<size_t>(sizes[k]), false);
+
+				for (unsigned long long i = 0; i < sizes[k]; ++i)
+				{
+					unsigned long long element = permutation[i];
+
+					Assert::IsTrue(element < sizes[k]);
+					Assert::IsFalse(seen[static_cast<size_t>(element)]);
+					Assert::IsTrue(permutation.Unmap(element) == i);
+
+					seen[static_cast<size_t>(element)] = true;
+				}
+			}
+		}
+
+		TEST_METHOD(TestPermutationSeed)
+		{
+			// same seed gives the same order, different seeds differ
+
+			Random a(42);
+			Random b(42);
+			Random c(43);
+			Permutation pa(a, 1000);
+			Permutation pb(b, 1000);
+			Permutation pc(c, 1000);
+			int same = 0;
+			int fixed = 0;
+
+			for (unsigned long long i = 0; i < 1000; ++i)
+			{
+				Assert::IsTrue(pa[i] == pb[i]);
+
+				if (pa[i] == pc[i])
+					++same;
+
+				if (pa[i] == i)
+					++fixed;
+			}
+
+			// a random permutation has about one fixed point and one match with another
+
+			Assert::IsTrue(same < 10);
+			Assert::IsTrue(fixed < 10);
+
+			// first element over many keys is close to uniform
+
+			const int size = 10;
+			const int loopnum = 20000;
+			int counts[size] = {};
+
+			for (int i = 0; i < loopnum; ++i)
+			{
+				Permutation permutation(a, size);
+				++counts[permutation[0]];
+			}
+
+			for (int i = 0; i < size; ++i)
+				Assert::AreEqual(static_cast<double>(loopnum) / size, static_cast<double>(counts[i]), 150.0);
+		}
+
+		TEST_METHOD(TestPermutationHuge)
+		{
+			// 10^12 elements, random access and bulk evaluation without any table
+
+			const unsigned long long size = 1000000000000ull;
+			Random random(7);
+			Permutation permutation(random, size);
+			unsigned long long values[64];
+
+			permutation.Map(size - 64, values, 64);
+
+			for (int i = 0; i < 64; ++i)
+			{
+				unsigned long long position = size - 64 + i;
+
+				Assert::IsTrue(values[i] < size);
+				Assert::IsTrue(values[i] == permutation[position]);
+				Assert::IsTrue(permutation.Unmap(values[i]) == position);
+			}
+		}
+
+		TEST_METHOD(TestPermutationSplit)
+		{
+			// parts cover every position once, threads visit their parts in parallel
+
+			const unsigned long long size = 100003;
+			const int parts = 4;
+			Random random(99);
+			Permutation permutation(random, size);
+			std::vector<unsigned long long> elements(static_cast<size_t>(size));
+			std::vector<std::thread> threads;
+			unsigned long long expected_begin = 0;
+
+			for (int part = 0; part < parts; ++part)
+			{
+				unsigned long long begin;
+				unsigned long long end;
+
+				permutation.Split(part, parts, begin, end);
+
+				Assert::IsTrue(begin == expected_begin);
+				expected_begin = end;
+
+				threads.push_back(std::thread([&permutation, &elements, begin, end]()
+				{
+					for (unsigned long long i = begin; i < end; i += 1000)
+					{
+						int count = static_cast<int>((end - i < 1000) ? (end - i) : 1000);
+						permutation.Map(i, &elements[static_cast<size_t>(i)], count);
+					}
+				}));
+			}
+
+			for (size_t i = 0; i < threads.size(); ++i)
+				threads[i].join();
+
+			Assert::IsTrue(expected_begin == size);
+
+			std::vector<bool> seen(static_cast<size_t>(size), false);
+
+			for (size_t i = 0; i < elements.size(); ++i)
+			{
+				Assert::IsFalse(seen[static_cast<size_t>(elements[i])]);
+				seen[static_cast<size_t>(elements[i])] = true;
+			}
+		}
+
+		TEST_METHOD(TestPermutationThroughput)
+		{
+			// log positions mapped per second for a small and a huge range
+
+			typedef std::chrono::high_resolution_clock Clock;
+
+			unsigned long long sizes[2] = { 10000000ull, 1000000000000ull };
+			const int count = 1 << 20;
+			std::vector<unsigned long long> values(count);
+			Random random(5);
+
+			for (int k = 0; k < 2; ++k)
+			{
+				Permutation permutation(random, sizes[k]);
+
+				Clock::time_point start = Clock::now();
+				permutation.Map(0, &values[0], count);
+				double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+				char output[128];
+				sprintf_s(output, "size %llu: %.1f M positions/s, %u bytes\n",
+					sizes[k], count / seconds * 1e-6, static_cast<unsigned>(sizeof(permutation)));
+				Logger::WriteMessage(output);
+			}
+
+			Assert::IsTrue(values[0] != values[1]);
+		}
+	};
+}
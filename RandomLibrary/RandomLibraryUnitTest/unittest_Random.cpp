@@ -1,6 +1,11 @@
 #include "stdafx.h"
 #include "CppUnitTest.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 namespace RandomLibraryUnitTest
@@ -306,5 +311,432 @@ namespace RandomLibraryUnitTest
 				Assert::IsTrue(std::abs(percentage - 0.5f) < 0.01f);
 			}
 		}
+
+		// RangeFloats
+		TEST_METHOD(TestRangeFloats)
+		{
+			// same values as RangeFloat with each element's boundries
+
+			const int count = 1003;
+			Random scalar(1234);
+			Random batch(1234);
+			std::vector<float> lower(count);
+			std::vector<float> upper(count);
+			std::vector<float> output(count);
+
+			for (int i = 0; i < count; ++i)
+			{
+				lower[i] = static_cast<float>(i) - 100.0f;
+				upper[i] = lower[i] + static_cast<float>(i % 13) + 0.5f;
+			}
+
+			batch.RangeFloats(&output[0], &lower[0], &upper[0], count);
+
+			for (int i = 0; i < count; ++i)
+			{
+				Assert::AreEqual(scalar.RangeFloat(lower[i], upper[i]), output[i]);
+				Assert::IsTrue((output[i] >= lower[i]) && (output[i] <= upper[i]));
+			}
+
+			Assert::AreEqual(scalar.RangeInt(), batch.RangeInt());
+		}
+
+		// NormalRanges, NormalRangesMinMax
+		TEST_METHOD(TestNormalRanges)
+		{
+			// same values as NormalRange / NormalRangeMinMax up to rounding, clamped the same way
+
+			const int count = 1003;
+			Random scalar(99);
+			Random batch(99);
+			std::vector<float> mean(count);
+			std::vector<float> stddev(count);
+			std::vector<float> output(count);
+
+			for (int i = 0; i < count; ++i)
+			{
+				mean[i] = static_cast<float>(i % 17) * 2.0f - 10.0f;
+				stddev[i] = 0.1f + static_cast<float>(i % 5);
+			}
+
+			batch.NormalRanges(&output[0], &mean[0], &stddev[0], count);
+
+			for (int i = 0; i < count; ++i)
+			{
+				Assert::AreEqual(scalar.NormalRange(mean[i], stddev[i]), output[i], 1e-5f * (1.0f + std::abs(output[i])));
+				Assert::IsTrue((output[i] >= scalar.NormalMin(mean[i], stddev[i])) && (output[i] <= scalar.NormalMax(mean[i], stddev[i])));
+			}
+
+			batch.NormalRanges(&output[0], &mean[0], &stddev[0], count, false);
+
+			for (int i = 0; i < count; ++i)
+				Assert::AreEqual(scalar.NormalRange(mean[i], stddev[i], false), output[i], 1e-5f * (1.0f + std::abs(output[i])));
+
+			// boundries from mean and stddev
+
+			std::vector<float> lower(count);
+			std::vector<float> upper(count);
+
+			for (int i = 0; i < count; ++i)
+			{
+				lower[i] = mean[i] - stddev[i];
+				upper[i] = mean[i] + stddev[i] * 2.0f;
+			}
+
+			batch.NormalRangesMinMax(&output[0], &lower[0], &upper[0], count);
+
+			for (int i = 0; i < count; ++i)
+			{
+				Assert::AreEqual(scalar.NormalRangeMinMax(lower[i], upper[i]), output[i], 1e-5f * (1.0f + std::abs(output[i])));
+				Assert::IsTrue((output[i] >= lower[i]) && (output[i] <= upper[i]));
+			}
+
+			Assert::AreEqual(scalar.RangeInt(), batch.RangeInt());
+		}
+
+		TEST_METHOD(TestBatchThroughput)
+		{
+			// log ns per value of per-element scalar calls and the batch APIs
+
+			typedef std::chrono::high_resolution_clock Clock;
+
+			const int count = 1 << 20;
+			Random random(5);
+			std::vector<float> lower(count);
+			std::vector<float> upper(count);
+			std::vector<float> output(count);
+			double seconds[4];
+			double checksum = 0.0;
+
+			random.FillFloat(&lower[0], count, -10.0f, 0.0f);
+			random.FillFloat(&upper[0], count, 1.0f, 10.0f);
+
+			Clock::time_point start = Clock::now();
+
+			for (int i = 0; i < count; ++i)
+				output[i] = random.RangeFloat(lower[i], upper[i]);
+
+			seconds[0] = std::chrono::duration<double>(Clock::now() - start).count();
+			checksum += output[count - 1];
+
+			start = Clock::now();
+			random.RangeFloats(&output[0], &lower[0], &upper[0], count);
+			seconds[1] = std::chrono::duration<double>(Clock::now() - start).count();
+			checksum += output[count - 1];
+
+			start = Clock::now();
+
+			for (int i = 0; i < count; ++i)
+				output[i] = random.NormalRangeMinMax(lower[i], upper[i]);
+
+			seconds[2] = std::chrono::duration<double>(Clock::now() - start).count();
+			checksum += output[count - 1];
+
+			start = Clock::now();
+			random.NormalRangesMinMax(&output[0], &lower[0], &upper[0], count);
+			seconds[3] = std::chrono::duration<double>(Clock::now() - start).count();
+			checksum += output[count - 1];
+
+			char output_text[256];
+			sprintf_s(output_text, "RangeFloat: %.2f ns/value\nRangeFloats: %.2f ns/value\nNormalRangeMinMax: %.2f ns/value\nNormalRangesMinMax: %.2f ns/value\n(checksum %.3f)\n",
+				seconds[0] / count * 1e9, seconds[1] / count * 1e9, seconds[2] / count * 1e9, seconds[3] / count * 1e9, checksum);
+			Logger::WriteMessage(output_text);
+
+			Assert::IsTrue((output[0] >= lower[0]) && (output[0] <= upper[0]));
+		}
+
+		TEST_METHOD(TestUnitFromBits)
+		{
+			// the extreme words land on the interval ends, or the nearest number inside
+
+			Assert::AreEqual(0.0f, UnitFloatFromBits(0u, RANDOM_CLOSED_OPEN));
+			Assert::AreEqual(1.0f - 1.0f / 16777216.0f, UnitFloatFromBits(0xFFFFFFFFu, RANDOM_CLOSED_OPEN));
+			Assert::AreEqual(1.0f / 16777216.0f, UnitFloatFromBits(0u, RANDOM_OPEN_CLOSED));
+			Assert::AreEqual(1.0f, UnitFloatFromBits(0xFFFFFFFFu, RANDOM_OPEN_CLOSED));
+			Assert::AreEqual(1.0f / 16777216.0f, UnitFloatFromBits(0u, RANDOM_OPEN_OPEN));
+			Assert::AreEqual(1.0f - 1.0f / 16777216.0f, UnitFloatFromBits(0xFFFFFFFFu, RANDOM_OPEN_OPEN));
+
+			Assert::AreEqual(0.0, UnitDoubleFromBits(0ull, RANDOM_CLOSED_OPEN));
+			Assert::AreEqual(1.0 - 1.0 / 9007199254740992.0, UnitDoubleFromBits(~0ull, RANDOM_CLOSED_OPEN));
+			Assert::AreEqual(1.0, UnitDoubleFromBits(~0ull, RANDOM_OPEN_CLOSED));
+			Assert::AreEqual(1.0 / 9007199254740992.0, UnitDoubleFromBits(0ull, RANDOM_OPEN_OPEN));
+
+			Assert::AreEqual(static_cast<unsigned short>(0x0000), UnitHalfFromBits(0u, RANDOM_CLOSED_OPEN));
+			Assert::AreEqual(static_cast<unsigned short>(0x3BFF), UnitHalfFromBits(0xFFFFFFFFu, RANDOM_CLOSED_OPEN));
+			Assert::AreEqual(static_cast<unsigned short>(0x3C00), UnitHalfFromBits(0xFFFFFFFFu, RANDOM_OPEN_CLOSED));
+			Assert::AreEqual(static_cast<unsigned short>(0x1000), UnitHalfFromBits(0u, RANDOM_OPEN_OPEN));
+		}
+
+		TEST_METHOD(TestHalfConversion)
+		{
+			// every finite half survives a round trip through float
+
+			for (unsigned int half = 0; half < 0x10000; ++half)
+			{
+				if ((half & 0x7C00) == 0x7C00)
+					continue;
+
+				Assert::AreEqual(static_cast<unsigned short>(half), FloatToHalf(HalfToFloat(static_cast<unsigned short>(half))));
+			}
+
+			// rounding to nearest, ties to even, subnormals and overflow
+
+			Assert::AreEqual(static_cast<unsigned short>(0x3C00), FloatToHalf(1.0f));
+			Assert::AreEqual(static_cast<unsigned short>(0x3C00), FloatToHalf(1.0f + 1.0f / 2048.0f));
+			Assert::AreEqual(static_cast<unsigned short>(0x3C02), FloatToHalf(1.0f + 3.0f / 2048.0f));
+			Assert::AreEqual(static_cast<unsigned short>(0xC000), FloatToHalf(-2.0f));
+			Assert::AreEqual(static_cast<unsigned short>(0x7BFF), FloatToHalf(65504.0f));
+			Assert::AreEqual(static_cast<unsigned short>(0x7BFF), FloatToHalf(65519.0f));
+			Assert::AreEqual(static_cast<unsigned short>(0x7C00), FloatToHalf(65520.0f));
+			Assert::AreEqual(static_cast<unsigned short>(0x0001), FloatToHalf(1.0f / 16777216.0f));
+			Assert::AreEqual(static_cast<unsigned short>(0x0000), FloatToHalf(1.0f / 33554432.0f));
+			Assert::AreEqual(static_cast<unsigned short>(0x0400), FloatToHalf(1.0f / 16384.0f));
+			Assert::AreEqual(static_cast<unsigned short>(0x0000), FloatToHalf(1e-9f));
+
+			Assert::AreEqual(static_cast<unsigned short>(0x0001), HalfStep(0x0000, true));
+			Assert::AreEqual(static_cast<unsigned short>(0x8001), HalfStep(0x0000, false));
+			Assert::AreEqual(static_cast<unsigned short>(0x3BFF), HalfStep(0x3C00, false));
+			Assert::AreEqual(static_cast<unsigned short>(0xBBFF), HalfStep(0xBC00, true));
+		}
+
+		TEST_METHOD(TestUnitIntervals)
+		{
+			// every mode stays inside its interval and averages 0.5
+
+			RandomInterval intervals[3] = { RANDOM_CLOSED_OPEN, RANDOM_OPEN_CLOSED, RANDOM_OPEN_OPEN };
+			Random random(38);
+			int loopnum = 200000;
+
+			for (int k = 0; k < 3; ++k)
+			{
+				bool is_zero_allowed = (intervals[k] == RANDOM_CLOSED_OPEN);
+				bool is_one_allowed = (intervals[k] == RANDOM_OPEN_CLOSED);
+
+				for (int full = 0; full < 2; ++full)
+				{
+					double sums[3] = {};
+
+					for (int i = 0; i < loopnum; ++i)
+					{
+						float f = random.UnitFloat(intervals[k], full != 0);
+						double d = random.UnitDouble(intervals[k], full != 0);
+						float h = HalfToFloat(random.UnitHalf(intervals[k], full != 0));
+
+						Assert::IsTrue((f > 0.0f || (is_zero_allowed && f == 0.0f)) && (f < 1.0f || (is_one_allowed && f == 1.0f)));
+						Assert::IsTrue((d > 0.0 || (is_zero_allowed && d == 0.0)) && (d < 1.0 || (is_one_allowed && d == 1.0)));
+						Assert::IsTrue((h > 0.0f || (is_zero_allowed && h == 0.0f)) && (h < 1.0f || (is_one_allowed && h == 1.0f)));
+
+						sums[0] += f;
+						sums[1] += d;
+						sums[2] += h;
+					}
+
+					for (int i = 0; i < 3; ++i)
+						Assert::AreEqual(0.5, sums[i] / loopnum, 0.005);
+				}
+			}
+		}
+
+		TEST_METHOD(TestUnitFullPrecision)
+		{
+			// full precision reaches below 2^-24 (fixed precision never does) with the right odds,
+			// and numbers near 0 use their whole mantissa
+
+			Random random(2016);
+			int loopnum = 1 << 20;
+			int below_float = 0;
+			int below_double = 0;
+			int fine_float = 0;
+
+			for (int i = 0; i < loopnum; ++i)
+			{
+				float f = random.UnitFloat(RANDOM_CLOSED_OPEN, true);
+				double d = random.UnitDouble(RANDOM_CLOSED_OPEN, true);
+
+				below_float += (f < 1.0f / 1024.0f) ? 1 : 0;
+				below_double += (d < 1.0 / 1024.0) ? 1 : 0;
+
+				// a multiple of 2^-24 is all fixed precision can give
+
+				float scaled = f * 16777216.0f;
+				fine_float += ((f < 1.0f / 1024.0f) && (scaled != std::floor(scaled))) ? 1 : 0;
+			}
+
+			Assert::AreEqual(1.0 / 1024.0, static_cast<double>(below_float) / loopnum, 0.0002);
+			Assert::AreEqual(1.0 / 1024.0, static_cast<double>(below_double) / loopnum, 0.0002);
+			Assert::IsTrue(fine_float > below_float / 2);
+
+			for (int i = 0; i < loopnum; ++i)
+			{
+				float f = random.UnitFloat(RANDOM_CLOSED_OPEN, false);
+				float scaled = f * 16777216.0f;
+
+				Assert::AreEqual(std::floor(scaled), scaled);
+			}
+		}
+
+		TEST_METHOD(TestRangeExcludesEnds)
+		{
+			// one float (and double) step between min and max, where rounding lands on max half the time:
+			// RangeFloat(min, max) can return max, the interval versions never return an excluded end
+
+			Random random(3);
+			float lower = 16777216.0f;
+			float upper = 16777218.0f;
+			int hits = 0;
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				hits += (random.RangeFloat(lower, upper) == upper) ? 1 : 0;
+				Assert::AreEqual(lower, random.RangeFloat(lower, upper, RANDOM_CLOSED_OPEN));
+				Assert::AreEqual(upper, random.RangeFloat(lower, upper, RANDOM_OPEN_CLOSED));
+				Assert::AreEqual(9007199254740992.0, random.RangeDouble(9007199254740992.0, 9007199254740994.0, RANDOM_CLOSED_OPEN));
+				Assert::AreEqual(9007199254740994.0, random.RangeDouble(9007199254740992.0, 9007199254740994.0, RANDOM_OPEN_CLOSED));
+				Assert::AreEqual(static_cast<unsigned short>(0x3C00), random.RangeHalf(1.0f, 1.0f + 1.0f / 1024.0f, RANDOM_CLOSED_OPEN));
+				Assert::AreEqual(static_cast<unsigned short>(0x3C01), random.RangeHalf(1.0f, 1.0f + 1.0f / 1024.0f, RANDOM_OPEN_CLOSED));
+			}
+
+			Assert::IsTrue(hits > 0);
+
+			for (int i = 0; i < 10000; ++i)
+			{
+				float f = random.RangeFloat(-3.0f, 5.0f, RANDOM_OPEN_OPEN);
+				double d = random.RangeDouble(-3.0, 5.0, RANDOM_OPEN_OPEN);
+				float h = HalfToFloat(random.RangeHalf(-3.0f, 5.0f, RANDOM_OPEN_OPEN));
+
+				Assert::IsTrue((f > -3.0f) && (f < 5.0f));
+				Assert::IsTrue((d > -3.0) && (d < 5.0));
+				Assert::IsTrue((h > -3.0f) && (h < 5.0f));
+			}
+		}
+
+		TEST_METHOD(TestUnitFill)
+		{
+			// bulk fills give the same sequence as the scalar calls
+
+			const int count = 1027;
+			RandomInterval intervals[3] = { RANDOM_CLOSED_OPEN, RANDOM_OPEN_CLOSED, RANDOM_OPEN_OPEN };
+			Random scalar(77);
+			Random bulk(77);
+			std::vector<float> floats(count);
+			std::vector<double> doubles(count);
+
+			for (int k = 0; k < 3; ++k)
+			{
+				for (int full = 0; full < 2; ++full)
+				{
+					bulk.FillUnitFloat(&floats[0], count, intervals[k], full != 0);
+					bulk.FillUnitDouble(&doubles[0], count, intervals[k], full != 0);
+
+					for (int i = 0; i < count; ++i)
+						Assert::AreEqual(scalar.UnitFloat(intervals[k], full != 0), floats[i]);
+
+					for (int i = 0; i < count; ++i)
+						Assert::AreEqual(scalar.UnitDouble(intervals[k], full != 0), doubles[i]);
+				}
+			}
+
+			Assert::AreEqual(scalar.RawBits(), bulk.RawBits());
+
+			// reseeding drops the words drawn ahead
+
+			Random fresh(5);
+			Random reseeded(5);
+
+			reseeded.UnitFloat();
+			reseeded.SetSeed(5);
+
+			for (int i = 0; i < 100; ++i)
+				Assert::AreEqual(fresh.UnitFloat(), reseeded.UnitFloat());
+		}
+
+		TEST_METHOD(TestUnitThroughput)
+		{
+			// log ns per value of every mode next to RangeFloat (uniform_real_distribution)
+
+			typedef std::chrono::high_resolution_clock Clock;
+
+			const int count = 1 << 20;
+			Random random(11);
+			std::vector<float> floats(count);
+			std::vector<double> doubles(count);
+			std::vector<unsigned short> halves(count);
+			const char *interval_names[3] = { "[0, 1)", "(0, 1]", "(0, 1)" };
+			RandomInterval intervals[3] = { RANDOM_CLOSED_OPEN, RANDOM_OPEN_CLOSED, RANDOM_OPEN_OPEN };
+			double checksum = 0.0;
+			char output[256];
+
+			// RangeFloat against fixed precision UnitFloat, best of a few alternating rounds
+			// so a busy machine does not favour either
+
+			double best[2] = { 1e9, 1e9 };
+			Clock::time_point start;
+
+			for (int round = 0; round < 5; ++round)
+			{
+				start = Clock::now();
+
+				for (int i = 0; i < count; ++i)
+					floats[i] = random.RangeFloat();
+
+				best[0] = (std::min)(best[0], std::chrono::duration<double>(Clock::now() - start).count());
+				checksum += floats[count - 1];
+				start = Clock::now();
+
+				for (int i = 0; i < count; ++i)
+					floats[i] = random.UnitFloat();
+
+				best[1] = (std::min)(best[1], std::chrono::duration<double>(Clock::now() - start).count());
+				checksum += floats[count - 1];
+			}
+
+			sprintf_s(output, "RangeFloat: %.2f ns/value, UnitFloat: %.2f ns/value (best of 5)\n",
+				best[0] / count * 1e9, best[1] / count * 1e9);
+			Logger::WriteMessage(output);
+
+			for (int k = 0; k < 3; ++k)
+			{
+				for (int full = 0; full < 2; ++full)
+				{
+					double timings[4];
+
+					start = Clock::now();
+
+					for (int i = 0; i < count; ++i)
+						floats[i] = random.UnitFloat(intervals[k], full != 0);
+
+					timings[0] = std::chrono::duration<double>(Clock::now() - start).count();
+					checksum += floats[count - 1];
+
+					start = Clock::now();
+
+					for (int i = 0; i < count; ++i)
+						doubles[i] = random.UnitDouble(intervals[k], full != 0);
+
+					timings[1] = std::chrono::duration<double>(Clock::now() - start).count();
+					checksum += doubles[count - 1];
+
+					start = Clock::now();
+
+					for (int i = 0; i < count; ++i)
+						halves[i] = random.UnitHalf(intervals[k], full != 0);
+
+					timings[2] = std::chrono::duration<double>(Clock::now() - start).count();
+					checksum += HalfToFloat(halves[count - 1]);
+
+					start = Clock::now();
+					random.FillUnitFloat(&floats[0], count, intervals[k], full != 0);
+					timings[3] = std::chrono::duration<double>(Clock::now() - start).count();
+					checksum += floats[count - 1];
+
+					sprintf_s(output, "%s %s: UnitFloat %.2f, UnitDouble %.2f, UnitHalf %.2f, FillUnitFloat %.2f ns/value\n",
+						interval_names[k], full ? "full precision" : "fixed precision",
+						timings[0] / count * 1e9, timings[1] / count * 1e9, timings[2] / count * 1e9, timings[3] / count * 1e9);
+					Logger::WriteMessage(output);
+				}
+			}
+
+			Assert::IsTrue(checksum > 0.0);
+		}
 	};
-}
\ No newline at end of file
+}
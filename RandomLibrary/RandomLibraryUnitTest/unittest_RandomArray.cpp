@@ -0,0 +1,254 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <chrono>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace RandomLibraryUnitTest
+{
+	TEST_CLASS(UnitTest_RandomArray)
+	{
+	public:
+
+		TEST_METHOD(TestArraySeed)
+		{
+			// same seed gives the same streams, entities and seeds differ
+
+			const int count = 1001;
+			RandomArray first(count, 42);
+			RandomArray second(count, 42);
+			RandomArray other(count, 43);
+			std::vector<unsigned int> a(count), b(count), c(count);
+			int same_seed = 0;
+			int same_entity = 0;
+
+			for (int k = 0; k < 10; ++k)
+			{
+				first.FillRawBits(&a[0]);
+				second.FillRawBits(&b[0]);
+				other.FillRawBits(&c[0]);
+
+				for (int i = 0; i < count; ++i)
+				{
+					Assert::AreEqual(a[i], b[i]);
+					same_seed += (a[i] == c[i]) ? 1 : 0;
+					same_entity += ((i > 0) && (a[i] == a[i - 1])) ? 1 : 0;
+				}
+			}
+
+			Assert::IsTrue(same_seed < 3);
+			Assert::IsTrue(same_entity < 3);
+
+			// reseeding restarts the streams
+
+			first.SetSeed(42);
+			second.SetSeed(42);
+			Assert::AreEqual(42u, first.GetSeed());
+
+			for (int i = 0; i < count; ++i)
+				Assert::AreEqual(second.RawBits(i), first.RawBits(i));
+
+			Assert::AreEqual(static_cast<size_t>(count * 16), first.GetMemory());
+		}
+
+		TEST_METHOD(TestArrayJump)
+		{
+			// one jump of count is count single jumps (which only apply the reference polynomial),
+			// jumping 0 keeps the streams and a jumped stream differs from the plain one
+
+			const int count = 13;
+			RandomArray single(count, 7);
+			RandomArray jumped(count, 7);
+			RandomArray kept(count, 7);
+			RandomArray plain(count, 7);
+			std::vector<unsigned int> a(count), b(count), c(count), d(count);
+			int same = 0;
+
+			for (int k = 0; k < 37; ++k)
+				single.Jump(1);
+
+			jumped.Jump(37);
+			kept.Jump(0);
+
+			for (int k = 0; k < 10; ++k)
+			{
+				single.FillRawBits(&a[0]);
+				jumped.FillRawBits(&b[0]);
+				kept.FillRawBits(&c[0]);
+				plain.FillRawBits(&d[0]);
+
+				for (int i = 0; i < count; ++i)
+				{
+					Assert::AreEqual(a[i], b[i]);
+					Assert::AreEqual(d[i], c[i]);
+					same += (a[i] == d[i]) ? 1 : 0;
+				}
+			}
+
+			Assert::IsTrue(same < 3);
+		}
+
+		TEST_METHOD(TestArrayBulkMatchesSingle)
+		{
+			// every bulk function gives each entity what its per-index call gives,
+			// the SIMD groups and the scalar tail included (count is not a multiple of 4)
+
+			const int count = 1027;
+			RandomArray single(count, 7);
+			RandomArray bulk(count, 7);
+			std::vector<unsigned int> bits(count);
+			std::vector<int> ints(count);
+			std::vector<float> floats(count);
+			bool tosses[count];
+
+			for (int k = 0; k < 20; ++k)
+			{
+				bulk.FillRawBits(&bits[0]);
+				bulk.FillInt(&ints[0], -5, 17);
+				bulk.FillFloat(&floats[0], -2.0f, 3.0f);
+				bulk.FillCoinToss(tosses, 0.3f);
+
+				for (int i = 0; i < count; ++i)
+				{
+					Assert::AreEqual(single.RawBits(i), bits[i]);
+					Assert::AreEqual(single.RangeInt(i, -5, 17), ints[i]);
+					Assert::AreEqual(single.RangeFloat(i, -2.0f, 3.0f), floats[i]);
+					Assert::AreEqual(single.CoinToss(i, 0.3f), tosses[i]);
+				}
+			}
+
+			// rerolls for the biased words keep entities in step (a range that rerolls often)
+
+			for (int k = 0; k < 20; ++k)
+			{
+				bulk.FillInt(&ints[0], 0, 0x7FFFFFFF - 0x1FFFFFFF);
+
+				for (int i = 0; i < count; ++i)
+					Assert::AreEqual(single.RangeInt(i, 0, 0x7FFFFFFF - 0x1FFFFFFF), ints[i]);
+			}
+
+			for (int i = 0; i < count; ++i)
+				Assert::AreEqual(single.RawBits(i), bulk.RawBits(i));
+		}
+
+		TEST_METHOD(TestArrayDistribution)
+		{
+			// ranges are respected and roughly uniform, coin tosses match the percentage
+
+			const int count = 4096;
+			RandomArray array(count, 2016);
+			std::vector<int> ints(count);
+			std::vector<float> floats(count);
+			std::vector<char> tosses(count);
+			int buckets[10] = {};
+			int heads = 0;
+			double sum = 0.0;
+			int loopnum = 50;
+
+			for (int k = 0; k < loopnum; ++k)
+			{
+				array.FillInt(&ints[0], 0, 9);
+				array.FillFloat(&floats[0], 1.0f, 2.0f);
+				array.FillCoinToss(reinterpret_cast<bool *>(&tosses[0]), 0.25f);
+
+				for (int i = 0; i < count; ++i)
+				{
+					Assert::IsTrue((ints[i] >= 0) && (ints[i] <= 9));
+					Assert::IsTrue((floats[i] >= 1.0f) && (floats[i] < 2.0f));
+					++buckets[ints[i]];
+					sum += floats[i];
+					heads += tosses[i] ? 1 : 0;
+				}
+			}
+
+			double total = static_cast<double>(count) * loopnum;
+
+			for (int i = 0; i < 10; ++i)
+				Assert::AreEqual(0.1, buckets[i] / total, 0.005);
+
+			Assert::AreEqual(1.5, sum / total, 0.005);
+			Assert::AreEqual(0.25, heads / total, 0.005);
+
+			Assert::AreEqual(-3, array.RangeInt(0, -3, -3));
+			Assert::IsFalse(array.CoinToss(0, 0.0f));
+			Assert::IsTrue(array.CoinToss(0, 1.0f));
+		}
+
+		TEST_METHOD(TestArrayThroughput)
+		{
+			// log bytes per entity and entity updates per second, next to one Random per entity
+
+			typedef std::chrono::high_resolution_clock Clock;
+
+			const int count = 1 << 20;
+			const int loopnum = 20;
+			RandomArray array(count, 1);
+			std::vector<unsigned int> bits(count);
+			std::vector<float> floats(count);
+			double checksum = 0.0;
+
+			Clock::time_point start = Clock::now();
+
+			for (int k = 0; k < loopnum; ++k)
+			{
+				array.FillRawBits(&bits[0]);
+				checksum += bits[k];
+			}
+
+			double raw = std::chrono::duration<double>(Clock::now() - start).count();
+
+			start = Clock::now();
+
+			for (int k = 0; k < loopnum; ++k)
+			{
+				array.FillFloat(&floats[0]);
+				checksum += floats[k];
+			}
+
+			double uniform = std::chrono::duration<double>(Clock::now() - start).count();
+
+			start = Clock::now();
+
+			for (int k = 0; k < loopnum; ++k)
+				for (int i = 0; i < count; ++i)
+					floats[i] = array.RangeFloat(i);
+
+			double single = std::chrono::duration<double>(Clock::now() - start).count();
+			checksum += floats[0];
+
+			// one Random per entity, fewer of them (each holds a whole engine)
+
+			const int random_count = 1 << 14;
+			std::vector<Random> randoms;
+
+			randoms.reserve(random_count);
+
+			for (int i = 0; i < random_count; ++i)
+				randoms.push_back(Random(i));
+
+			start = Clock::now();
+
+			for (int k = 0; k < loopnum; ++k)
+				for (int i = 0; i < random_count; ++i)
+					checksum += randoms[i].RangeFloat();
+
+			double engine = std::chrono::duration<double>(Clock::now() - start).count() * (count / random_count);
+
+			char output[256];
+
+			sprintf_s(output, "RandomArray: %.1f bytes/entity (Random: %d bytes/entity)\n",
+				static_cast<double>(array.GetMemory()) / count, static_cast<int>(sizeof(Random)));
+			Logger::WriteMessage(output);
+
+			double updates = static_cast<double>(count) * loopnum;
+
+			sprintf_s(output, "%d entities: FillRawBits %.1f M updates/s, FillFloat %.1f M updates/s, RangeFloat(i) %.1f M updates/s, Random per entity %.1f M updates/s\n",
+				count, updates / raw * 1e-6, updates / uniform * 1e-6, updates / single * 1e-6, updates / engine * 1e-6);
+			Logger::WriteMessage(output);
+
+			Assert::IsTrue(checksum > 0.0);
+		}
+	};
+}
@@ -0,0 +1,168 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <chrono>
+
+#include <Global.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace RandomLibraryUnitTest
+{
+	TEST_CLASS(UnitTest_RandomStats)
+	{
+	public:
+
+		TEST_METHOD(TestStatsDraws)
+		{
+			// every API call should be counted on the instance
+
+			Random random;
+			random.ResetStats();
+
+			for (int i = 0; i < 100; ++i)
+				random.RangeInt();
+			for (int i = 0; i < 200; ++i)
+				random.RangeFloat();
+			for (int i = 0; i < 300; ++i)
+				random.CoinToss();
+			for (int i = 0; i < 400; ++i)
+				random.NormalRangeMinMax(0.0f, 10.0f);
+
+			RandomStats stats = random.GetStats();
+			Logger::WriteMessage(stats.ToString().c_str());
+
+#ifdef RANDOM_INSTRUMENTATION
+			Assert::IsTrue(stats.draws[RANDOM_API_RANGE_INT] == 100);
+			Assert::IsTrue(stats.draws[RANDOM_API_RANGE_FLOAT] == 200);
+			Assert::IsTrue(stats.draws[RANDOM_API_COIN_TOSS] == 300);
+			Assert::IsTrue(stats.draws[RANDOM_API_NORMAL_RANGE_MINMAX] == 400);
+			Assert::IsTrue(stats.draws[RANDOM_API_NORMAL_RANGE] == 0);
+			Assert::IsTrue(stats.raw_words >= 1000);
+
+			// every clamped normal draw lands in one histogram bucket
+
+			unsigned long long histogram_total = 0;
+			unsigned long long reroll_total = 0;
+
+			for (int i = 0; i < RANDOM_REROLL_BUCKETS; ++i)
+			{
+				histogram_total += stats.reroll_histogram[i];
+				reroll_total += stats.reroll_histogram[i] * i;
+			}
+
+			Assert::IsTrue(histogram_total == 400);
+			Assert::IsTrue(reroll_total <= stats.rerolls);
+#else
+			Assert::IsTrue(stats.TotalDraws() == 0);
+			Assert::IsTrue(stats.raw_words == 0);
+#endif
+		}
+
+		TEST_METHOD(TestStatsReseed)
+		{
+			Random random(1234);
+			random.ResetStats();
+
+			random.SetSeed(42);
+			random.UseRandomSeed();
+			random.UseDefaultSeed();
+
+#ifdef RANDOM_INSTRUMENTATION
+			Assert::IsTrue(random.GetStats().reseeds == 3);
+
+			random.ResetStats();
+			Assert::IsTrue(random.GetStats().reseeds == 0);
+#else
+			Assert::IsTrue(random.GetStats().reseeds == 0);
+#endif
+		}
+
+		TEST_METHOD(TestThreadStats)
+		{
+			// thread counters are summed over every instance
+
+			Random::ResetThreadStats();
+
+			Random random1;
+			Random random2;
+			RandomStats total = random1.GetStats();
+
+			for (int i = 0; i < 50; ++i)
+			{
+				random1.RangeInt();
+				random2.RangeInt();
+			}
+
+			total.Clear();
+			total += random1.GetStats();
+			total += random2.GetStats();
+			RandomStats thread = Random::GetThreadStats();
+
+#ifdef RANDOM_INSTRUMENTATION
+			Assert::IsTrue(thread.draws[RANDOM_API_RANGE_INT] == 100);
+			Assert::IsTrue(thread.raw_words == total.raw_words);
+#else
+			Assert::IsTrue(thread.TotalDraws() == 0);
+#endif
+		}
+
+		TEST_METHOD(TestCallSites)
+		{
+			// the busiest g_random call site should come first
+
+			Random::ResetThreadStats();
+
+			for (int i = 0; i < 30; ++i)
+				g_random.RangeInt();
+			for (int i = 0; i < 10; ++i)
+				g_random.RangeFloat();
+
+			RandomCallSite sites[RANDOM_CALL_SITES];
+			int count = Random::GetThreadCallSites(sites, RANDOM_CALL_SITES);
+
+#ifdef RANDOM_INSTRUMENTATION
+			Assert::AreEqual(2, count);
+			Assert::IsTrue(sites[0].count == 30);
+			Assert::IsTrue(sites[1].count == 10);
+			Assert::IsTrue(sites[0].line < sites[1].line);
+#else
+			Assert::AreEqual(0, count);
+#endif
+		}
+
+		TEST_METHOD(TestStatsOverhead)
+		{
+			// log cost per draw (compare builds with and without RANDOM_INSTRUMENTATION)
+
+			typedef std::chrono::high_resolution_clock Clock;
+
+			Random random;
+			int loopnum = 1000000;
+			int checksum = 0;
+
+			Clock::time_point start = Clock::now();
+			for (int i = 0; i < loopnum; ++i)
+				checksum += random.RangeInt();
+			double range_int = std::chrono::duration<double>(Clock::now() - start).count();
+
+			float sum = 0.0f;
+			start = Clock::now();
+			for (int i = 0; i < loopnum; ++i)
+				sum += random.NormalRange();
+			double normal = std::chrono::duration<double>(Clock::now() - start).count();
+
+			char output[128];
+			sprintf_s(output, "instrumentation %s\nRangeInt: %.2f ns/draw\nNormalRange: %.2f ns/draw\n(checksum %d %.1f)\n",
+#ifdef RANDOM_INSTRUMENTATION
+				"on",
+#else
+				"off",
+#endif
+				range_int * 1e9 / loopnum, normal * 1e9 / loopnum, checksum, sum);
+			Logger::WriteMessage(output);
+
+			Assert::IsTrue(range_int > 0.0);
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <chrono>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace RandomLibraryUnitTest
+{
+	TEST_CLASS(UnitTest_RandomView)
+	{
+	public:
+
+		TEST_METHOD(TestFillSequence)
+		{
+			// bulk fills give the same values as the scalar calls
+
+			const int count = 1000;
+			Random scalar(1234);
+			Random bulk(1234);
+			std::vector<int> ints(count);
+			std::vector<float> floats(count);
+			std::vector<float> normals(count);
+
+			bulk.FillInt(&ints[0], count, -50, 50);
+			bulk.FillFloat(&floats[0], count, 1.0f, 2.0f);
+			bulk.FillNormal(&normals[0], count, 5.0f, 2.0f);
+
+			for (int i = 0; i < count; ++i)
+				Assert::AreEqual(scalar.RangeInt(-50, 50), ints[i]);
+
+			for (int i = 0; i < count; ++i)
+				Assert::AreEqual(scalar.RangeFloat(1.0f, 2.0f), floats[i]);
+
+			for (int i = 0; i < count; ++i)
+				Assert::AreEqual(scalar.NormalRange(5.0f, 2.0f), normals[i]);
+
+			Assert::AreEqual(scalar.RangeInt(), bulk.RangeInt());
+		}
+
+		TEST_METHOD(TestViewSequence)
+		{
+			// a limited view yields the scalar sequence and draws nothing past its limit
+
+			const int count = 1000;
+			Random scalar(99);
+			Random lazy(99);
+			int i = 0;
+
+			for (int value : RandomInts(lazy, 0, 100) | Take(count))
+			{
+				Assert::AreEqual(scalar.RangeInt(0, 100), value);
+				++i;
+			}
+
+			Assert::AreEqual(count, i);
+
+			i = 0;
+
+			for (float value : RandomNormals(lazy, 0.0f, 1.0f) | Take(count))
+			{
+				Assert::AreEqual(scalar.NormalRange(0.0f, 1.0f), value);
+				++i;
+			}
+
+			Assert::AreEqual(count, i);
+			Assert::AreEqual(scalar.RangeFloat(), lazy.RangeFloat());
+
+			// an unlimited view pulled generator style
+
+			RandomView<float, RandomFloatFill> floats = RandomFloats(lazy, -1.0f, 1.0f);
+
+			for (i = 0; i < count; ++i)
+				Assert::AreEqual(scalar.RangeFloat(-1.0f, 1.0f), floats.Next());
+		}
+
+		TEST_METHOD(TestViewTransform)
+		{
+			Random scalar(7);
+			Random lazy(7);
+			std::vector<int> expected;
+			std::vector<int> result;
+
+			for (int i = 0; i < 10; ++i)
+				expected.push_back(scalar.RangeInt(1, 6) * 10 + 1);
+
+			// Take works before or after Transform
+
+			for (int value : RandomInts(lazy, 1, 6) | Transform([](int x) { return x * 10; }) | Take(10) | Transform([](int x) { return x + 1; }))
+				result.push_back(value);
+
+			Assert::IsTrue(expected == result);
+
+			auto doubled = RandomFloats(lazy) | Transform([](float x) { return static_cast<double>(x) * 2.0; }) | Take(3);
+
+			for (int i = 0; i < 3; ++i)
+				Assert::AreEqual(static_cast<double>(scalar.RangeFloat()) * 2.0, doubled.Next());
+
+			Assert::IsTrue(doubled.IsDone());
+		}
+
+		TEST_METHOD(TestViewThroughput)
+		{
+			// log ns per value of a scalar loop, bulk fill and view iteration
+
+			typedef std::chrono::high_resolution_clock Clock;
+
+			const int count = 1 << 20;
+			const int block = 1024;
+			std::vector<int> buffer(block);
+			long long checksum[3] = { 0, 0, 0 };
+			double seconds[3];
+
+			{
+				Random random(5);
+				Clock::time_point start = Clock::now();
+
+				for (int i = 0; i < count; ++i)
+					checksum[0] += random.RangeInt(0, 100);
+
+				seconds[0] = std::chrono::duration<double>(Clock::now() - start).count();
+			}
+
+			{
+				Random random(5);
+				Clock::time_point start = Clock::now();
+
+				for (int i = 0; i < count; i += block)
+				{
+					random.FillInt(&buffer[0], block, 0, 100);
+
+					for (int j = 0; j < block; ++j)
+						checksum[1] += buffer[j];
+				}
+
+				seconds[1] = std::chrono::duration<double>(Clock::now() - start).count();
+			}
+
+			{
+				Random random(5);
+				Clock::time_point start = Clock::now();
+
+				for (int value : RandomInts(random, 0, 100) | Take(count))
+					checksum[2] += value;
+
+				seconds[2] = std::chrono::duration<double>(Clock::now() - start).count();
+			}
+
+			char output[256];
+			sprintf_s(output, "scalar: %.2f ns/value\nfill: %.2f ns/value\nview: %.2f ns/value\n(checksum %lld %lld %lld)\n",
+				seconds[0] / count * 1e9, seconds[1] / count * 1e9, seconds[2] / count * 1e9,
+				checksum[0], checksum[1], checksum[2]);
+			Logger::WriteMessage(output);
+
+			// every loop saw the same values
+
+			Assert::IsTrue(checksum[0] == checksum[1]);
+			Assert::IsTrue(checksum[0] == checksum[2]);
+		}
+	};
+}
@@ -0,0 +1,223 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace RandomLibraryUnitTest
+{
+	TEST_CLASS(UnitTest_Sampler)
+	{
+	public:
+
+		TEST_METHOD(TestAntithetic)
+		{
+			// pairs should mirror each other and stay in range
+
+			Random random;
+			Sampler sampler(random);
+			std::vector<float> uniform(1001);
+			std::vector<float> normal(1000);
+			bool testresult = true;
+
+			sampler.AntitheticFloats(uniform.data(), static_cast<int>(uniform.size()), 2.0f, 10.0f);
+			sampler.AntitheticNormals(normal.data(), static_cast<int>(normal.size()), 5.0f, 2.0f);
+
+			for (size_t i = 0; i + 1 < uniform.size(); i += 2)
+			{
+				if (std::abs(uniform[i] + uniform[i + 1] - 12.0f) > 0.0001f)
+					testresult = false;
+				if ((uniform[i + 1] < 2.0f) || (uniform[i + 1] > 10.0f))
+					testresult = false;
+			}
+
+			for (size_t i = 0; i < normal.size(); i += 2)
+			{
+				if (std::abs(normal[i] + normal[i + 1] - 10.0f) > 0.0001f)
+					testresult = false;
+				if ((normal[i + 1] < -1.0001f) || (normal[i + 1] > 11.0001f))
+					testresult = false;
+			}
+
+			Assert::IsTrue(testresult);
+		}
+
+		TEST_METHOD(TestStratified)
+		{
+			// every stratum should receive the same number of values
+
+			Random random;
+			Sampler sampler(random);
+			int strata = 16;
+			int count = strata * 8;
+			std::vector<float> output(count);
+			std::vector<int> histogram(strata);
+
+			sampler.StratifiedFloats(output.data(), count, strata, 0.0f, 16.0f);
+
+			for (int i = 0; i < count; ++i)
+			{
+				int k = static_cast<int>(output[i]);
+
+				if ((k >= 0) && (k < strata))
+					++histogram[k];
+			}
+
+			for (int k = 0; k < strata; ++k)
+				Assert::AreEqual(8, histogram[k]);
+		}
+
+		TEST_METHOD(TestLatinHypercube)
+		{
+			// every dimension should hit each stratum exactly once
+
+			Random random;
+			Sampler sampler(random);
+			int samples = 50;
+			int dimensions = 4;
+			std::vector<float> output(samples * dimensions);
+
+			sampler.LatinHypercube(output.data(), samples, dimensions, 0.0f, 50.0f);
+
+			for (int d = 0; d < dimensions; ++d)
+			{
+				std::vector<int> histogram(samples);
+
+				for (int i = 0; i < samples; ++i)
+				{
+					int k = static_cast<int>(output[i * dimensions + d]);
+
+					if ((k >= 0) && (k < samples))
+						++histogram[k];
+				}
+
+				for (int k = 0; k < samples; ++k)
+					Assert::AreEqual(1, histogram[k]);
+			}
+		}
+
+		TEST_METHOD(TestStratumRounding)
+		{
+			// strata one float wide: lower + width * u rounds up to the next stratum half the time,
+			// samples have to stay on their own stratum
+
+			Random random(27);
+			Sampler sampler(random);
+			float lower = 16777216.0f;
+			int strata = 4;
+			int count = strata * 64;
+			std::vector<float> output(count);
+
+			sampler.StratifiedFloats(output.data(), count, strata, lower, lower + 8.0f);
+
+			for (int i = 0; i < count; ++i)
+				Assert::AreEqual(lower + 2.0f * static_cast<float>(i / 64), output[i]);
+
+			std::vector<float> points(strata * 2);
+
+			for (int loop = 0; loop < 16; ++loop)
+			{
+				sampler.LatinHypercube(points.data(), strata, 2, lower, lower + 8.0f);
+
+				for (int d = 0; d < 2; ++d)
+				{
+					std::vector<int> histogram(strata);
+
+					for (int i = 0; i < strata; ++i)
+						++histogram[static_cast<int>((points[i * 2 + d] - lower) / 2.0f)];
+
+					for (int k = 0; k < strata; ++k)
+						Assert::AreEqual(1, histogram[k]);
+				}
+			}
+		}
+
+		TEST_METHOD(TestAntitheticRounding)
+		{
+			// the mirrored sum rounds: on a range one float wide about half of the mirrored values
+			// would fall outside it, and next to 1 the normal boundary is uneven (3 floats below, 2 above),
+			// mirrored values have to stay in range
+
+			Random random(27);
+			Sampler sampler(random);
+			float min = 0.1f;
+			float max = std::nextafter(min, 1.0f);
+			float stddev = std::ldexp(2.75f, -24) / 3.0f;
+			std::vector<float> output(10000);
+
+			sampler.AntitheticFloats(output.data(), static_cast<int>(output.size()), min, max);
+
+			for (size_t i = 0; i < output.size(); ++i)
+				Assert::IsTrue((output[i] >= min) && (output[i] <= max));
+
+			sampler.AntitheticNormals(output.data(), static_cast<int>(output.size()), 1.0f, stddev);
+
+			for (size_t i = 0; i < output.size(); ++i)
+				Assert::IsTrue((output[i] >= random.NormalMin(1.0f, stddev)) && (output[i] <= random.NormalMax(1.0f, stddev)));
+		}
+
+		TEST_METHOD(TestVarianceReduction)
+		{
+			// estimate E[exp(u)] and E[exp(x + y)] many times with each mode
+			// and compare the variance of the estimates at equal sample count
+
+			Random random;
+			Sampler sampler(random);
+			int n = 64;
+			int repeats = 2000;
+			std::vector<float> u(n);
+			std::vector<float> points(n * 2);
+			double sum[5] = {};
+			double sum_sq[5] = {};
+
+			for (int r = 0; r < repeats; ++r)
+			{
+				double estimate[5] = {};
+
+				for (int i = 0; i < n; ++i)
+					estimate[0] += std::exp(random.RangeFloat());
+
+				sampler.AntitheticFloats(u.data(), n);
+				for (int i = 0; i < n; ++i)
+					estimate[1] += std::exp(u[i]);
+
+				sampler.StratifiedFloats(u.data(), n, n);
+				for (int i = 0; i < n; ++i)
+					estimate[2] += std::exp(u[i]);
+
+				for (int i = 0; i < n; ++i)
+					estimate[3] += std::exp(random.RangeFloat() + random.RangeFloat());
+
+				sampler.LatinHypercube(points.data(), n, 2);
+				for (int i = 0; i < n; ++i)
+					estimate[4] += std::exp(points[i * 2] + points[i * 2 + 1]);
+
+				for (int m = 0; m < 5; ++m)
+				{
+					estimate[m] /= n;
+					sum[m] += estimate[m];
+					sum_sq[m] += estimate[m] * estimate[m];
+				}
+			}
+
+			double variance[5];
+			for (int m = 0; m < 5; ++m)
+			{
+				double mean = sum[m] / repeats;
+				variance[m] = sum_sq[m] / repeats - mean * mean;
+			}
+
+			char output[256];
+			sprintf_s(output, "n = %d, variance of the estimate\nplain: %.3g\nantithetic: %.3g (%.1fx)\nstratified: %.3g (%.1fx)\n"
+				"plain 2D: %.3g\nlatin hypercube 2D: %.3g (%.1fx)\n", n,
+				variance[0], variance[1], variance[0] / variance[1], variance[2], variance[0] / variance[2],
+				variance[3], variance[4], variance[3] / variance[4]);
+			Logger::WriteMessage(output);
+
+			Assert::IsTrue(variance[1] < variance[0]);
+			Assert::IsTrue(variance[2] < variance[0]);
+			Assert::IsTrue(variance[4] < variance[3]);
+		}
+	};
+}
\ No newline at end of file
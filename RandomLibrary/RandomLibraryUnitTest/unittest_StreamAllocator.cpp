@@ -0,0 +1,306 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+// child processes started by TestStreamProcesses
+static const int STREAM_TEST_PROCESSES = 4;
+
+// child process side of TestStreamProcesses, run as
+//	rundll32.exe "<test dll>",StreamAllocatorWorker <stream name> <results name> <claims>
+// it claims blocks one at a time and counts each one in the shared results segment
+// (one counter per block, then one for blocks past the end)
+extern "C" void CALLBACK StreamAllocatorWorker(HWND window, HINSTANCE instance, LPSTR command_line, int show)
+{
+	std::istringstream arguments(command_line);
+	std::string name;
+	std::string results_name;
+	int claims = 0;
+
+	if (!(arguments >> name >> results_name >> claims))
+		return;
+
+	HANDLE results_mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, results_name.c_str());
+
+	if (!results_mapping)
+		return;
+
+	volatile LONG *results = static_cast<volatile LONG *>(MapViewOfFile(results_mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+	StreamAllocator allocator;
+
+	if (results && allocator.Open(name.c_str(), 0))
+	{
+		unsigned long long size = static_cast<unsigned long long>(claims) * STREAM_TEST_PROCESSES;
+
+		for (int i = 0; i < claims; ++i)
+		{
+			unsigned long long block = allocator.Claim();
+
+			InterlockedIncrement(&results[static_cast<size_t>((block < size) ? block : size)]);
+		}
+	}
+
+	if (results)
+		UnmapViewOfFile(const_cast<LONG *>(results));
+
+	CloseHandle(results_mapping);
+}
+
+// rundll32 looks the entry point up by its undecorated name
+#ifdef _WIN64
+#pragma comment(linker, "/EXPORT:StreamAllocatorWorker")
+#else
+#pragma comment(linker, "/EXPORT:StreamAllocatorWorker=_StreamAllocatorWorker@16")
+#endif
+
+namespace RandomLibraryUnitTest
+{
+	TEST_CLASS(UnitTest_StreamAllocator)
+	{
+	public:
+
+		TEST_METHOD(TestStreamShared)
+		{
+			// a second open of the name maps the same segment, like a second process would:
+			// it keeps the first seed and continues the same block counter
+
+			char name[64];
+			sprintf_s(name, "RandomStreamShared_%u", static_cast<unsigned int>(GetCurrentProcessId()));
+
+			StreamAllocator first;
+			StreamAllocator second;
+
+			Assert::IsFalse(first.IsOpen());
+			Assert::IsTrue(first.Open(name, 1234));
+			Assert::IsTrue(second.Open(name, 5678));
+			Assert::AreEqual(1234u, second.GetSeed());
+
+			Assert::AreEqual(0ull, first.Claim());
+			Assert::AreEqual(1ull, second.Claim());
+			Assert::AreEqual(2ull, first.Claim(10));
+			Assert::AreEqual(12ull, second.Claim());
+			Assert::AreEqual(13ull, first.GetClaimed());
+			Assert::AreEqual(first.BlockSeed(7), second.BlockSeed(7));
+
+			// a claimed block seeds the same stream as seeding with its block seed
+
+			Random random(0);
+			Random expected(first.BlockSeed(13));
+
+			Assert::AreEqual(13ull, second.Seed(random));
+
+			for (int i = 0; i < 100; ++i)
+				Assert::AreEqual(expected.RangeInt(), random.RangeInt());
+
+			// a claimed block of an array is the master seed jumped block times
+
+			RandomArray array(8, 0);
+			RandomArray expected_array(8, first.GetSeed());
+
+			expected_array.Jump(14);
+			Assert::AreEqual(14ull, first.Seed(array));
+
+			for (int i = 0; i < 8; ++i)
+				Assert::AreEqual(expected_array.RawBits(i), array.RawBits(i));
+
+			first.Close();
+			Assert::IsFalse(first.IsOpen());
+			Assert::AreEqual(15ull, second.GetClaimed());
+		}
+
+		TEST_METHOD(TestStreamDisjoint)
+		{
+			// workers with their own mapping claim concurrently, every block is handed out once
+			// and blocks get different seeds
+
+			char name[64];
+			sprintf_s(name, "RandomStreamDisjoint_%u", static_cast<unsigned int>(GetCurrentProcessId()));
+
+			const int workers = 8;
+			const int claims = 10000;
+			std::vector<std::vector<unsigned long long> > blocks(workers);
+			std::vector<std::thread> threads;
+
+			// held open so the segment outlives the workers (it is freed with the last mapping)
+
+			StreamAllocator allocator;
+			Assert::IsTrue(allocator.Open(name, 99));
+
+			for (int w = 0; w < workers; ++w)
+			{
+				threads.push_back(std::thread([&blocks, &name, w, claims]()
+				{
+					StreamAllocator worker;
+
+					if (!worker.Open(name, 0))
+						return;
+
+					for (int i = 0; i < claims; ++i)
+						blocks[w].push_back(worker.Claim());
+				}));
+			}
+
+			for (int w = 0; w < workers; ++w)
+				threads[w].join();
+
+			std::vector<unsigned long long> all;
+
+			for (int w = 0; w < workers; ++w)
+				all.insert(all.end(), blocks[w].begin(), blocks[w].end());
+
+			Assert::AreEqual(static_cast<size_t>(workers * claims), all.size());
+
+			std::sort(all.begin(), all.end());
+
+			for (size_t i = 0; i < all.size(); ++i)
+				Assert::AreEqual(static_cast<unsigned long long>(i), all[i]);
+
+			std::vector<unsigned int> seeds;
+
+			Assert::AreEqual(static_cast<unsigned long long>(all.size()), allocator.GetClaimed());
+			Assert::AreEqual(99u, allocator.GetSeed());
+
+			for (unsigned long long block = 0; block < all.size(); ++block)
+				seeds.push_back(allocator.BlockSeed(block));
+
+			std::sort(seeds.begin(), seeds.end());
+			Assert::IsTrue(std::adjacent_find(seeds.begin(), seeds.end()) == seeds.end());
+		}
+
+		TEST_METHOD(TestStreamAbandoned)
+		{
+			// a creator that died between taking the segment and setting it ready leaves the
+			// header state (its first LONG) at 1, Open gives up instead of waiting forever
+
+			char name[64];
+			sprintf_s(name, "RandomStreamAbandoned_%u", static_cast<unsigned int>(GetCurrentProcessId()));
+
+			HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, 64, name);
+			Assert::IsTrue(mapping != NULL);
+
+			volatile LONG *state = static_cast<volatile LONG *>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+			Assert::IsTrue(state != NULL);
+
+			InterlockedExchange(state, 1);
+
+			StreamAllocator allocator;
+			Assert::IsFalse(allocator.Open(name, 1234));
+			Assert::IsFalse(allocator.IsOpen());
+
+			UnmapViewOfFile(const_cast<LONG *>(state));
+			CloseHandle(mapping);
+		}
+
+		TEST_METHOD(TestStreamProcesses)
+		{
+			// child processes (rundll32 running StreamAllocatorWorker of this DLL) claim
+			// concurrently, every block is handed out to exactly one claim of one process
+
+			const int claims = 2500;
+			const int size = STREAM_TEST_PROCESSES * claims;
+
+			char name[64];
+			char results_name[64];
+			sprintf_s(name, "RandomStreamProcesses_%u", static_cast<unsigned int>(GetCurrentProcessId()));
+			sprintf_s(results_name, "RandomStreamResults_%u", static_cast<unsigned int>(GetCurrentProcessId()));
+
+			// held open so the segments outlive the children
+
+			StreamAllocator allocator;
+			Assert::IsTrue(allocator.Open(name, 99));
+
+			HANDLE results_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+				0, static_cast<DWORD>((size + 1) * sizeof(LONG)), results_name);
+			Assert::IsTrue(results_mapping != NULL);
+
+			volatile LONG *results = static_cast<volatile LONG *>(MapViewOfFile(results_mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+			Assert::IsTrue(results != NULL);
+
+			// command line of the children
+
+			HMODULE module = NULL;
+			char module_path[MAX_PATH];
+			char system_path[MAX_PATH];
+
+			Assert::IsTrue(GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+				reinterpret_cast<LPCSTR>(&StreamAllocatorWorker), &module) != FALSE);
+			Assert::IsTrue(GetModuleFileNameA(module, module_path, MAX_PATH) > 0);
+			Assert::IsTrue(GetSystemDirectoryA(system_path, MAX_PATH) > 0);
+
+			char command_line[3 * MAX_PATH];
+			sprintf_s(command_line, "\"%s\\rundll32.exe\" \"%s\",StreamAllocatorWorker %s %s %d",
+				system_path, module_path, name, results_name, claims);
+
+			// this DLL links the unit test framework DLL, which is not on the PATH of a plain process,
+			// the children inherit a PATH with its directory in front
+
+			std::string path;
+			char framework_path[MAX_PATH];
+			HMODULE framework = GetModuleHandleA("Microsoft.VisualStudio.TestTools.CppUnitTestFramework.dll");
+			DWORD length = GetEnvironmentVariableA("PATH", NULL, 0);
+
+			if (length > 0)
+			{
+				std::vector<char> buffer(length);
+				GetEnvironmentVariableA("PATH", &buffer[0], length);
+				path = &buffer[0];
+			}
+
+			if (framework && (GetModuleFileNameA(framework, framework_path, MAX_PATH) > 0))
+			{
+				std::string child_path(framework_path);
+				child_path.erase(child_path.find_last_of('\\'));
+				child_path += ";" + path;
+				SetEnvironmentVariableA("PATH", child_path.c_str());
+			}
+
+			HANDLE processes[STREAM_TEST_PROCESSES];
+			int started = 0;
+
+			for (int p = 0; p < STREAM_TEST_PROCESSES; ++p)
+			{
+				STARTUPINFOA startup = { sizeof(startup) };
+				PROCESS_INFORMATION process;
+
+				if (!CreateProcessA(NULL, command_line, NULL, NULL, FALSE, 0, NULL, NULL, &startup, &process))
+					break;
+
+				CloseHandle(process.hThread);
+				processes[started++] = process.hProcess;
+			}
+
+			SetEnvironmentVariableA("PATH", path.c_str());
+
+			DWORD wait = WAIT_FAILED;
+
+			if (started > 0)
+				wait = WaitForMultipleObjects(started, processes, TRUE, 60000);
+
+			for (int p = 0; p < started; ++p)
+				CloseHandle(processes[p]);
+
+			Assert::AreEqual(STREAM_TEST_PROCESSES, started);
+			Assert::IsTrue(wait != WAIT_TIMEOUT);
+			Assert::IsTrue(wait != WAIT_FAILED);
+
+			// every block counted once, none past the end
+
+			int missing = 0;
+
+			for (int block = 0; block <= size; ++block)
+				missing += (results[block] != ((block < size) ? 1 : 0)) ? 1 : 0;
+
+			Assert::AreEqual(0, missing);
+			Assert::AreEqual(static_cast<unsigned long long>(size), allocator.GetClaimed());
+
+			UnmapViewOfFile(const_cast<LONG *>(results));
+			CloseHandle(results_mapping);
+		}
+	};
+}
@@ -0,0 +1,203 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <chrono>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace RandomLibraryUnitTest
+{
+	TEST_CLASS(UnitTest_WeightedSampler)
+	{
+	public:
+
+		TEST_METHOD(TestWeightedDistribution)
+		{
+			// items are picked in proportion to their weights, weight 0 is never picked
+
+			WeightedSampler sampler;
+			double weights[5] = { 1.0, 0.0, 2.0, 3.0, 4.0 };
+
+			for (int i = 0; i < 5; ++i)
+				Assert::AreEqual(i, sampler.Insert(weights[i]));
+
+			Assert::AreEqual(10.0, sampler.GetTotal(), 1e-9);
+
+			Random random(1234);
+			int loopnum = 100000;
+			int counts[5] = {};
+
+			for (int i = 0; i < loopnum; ++i)
+				++counts[sampler.Sample(random)];
+
+			Assert::AreEqual(0, counts[1]);
+
+			for (int i = 0; i < 5; ++i)
+				Assert::AreEqual(weights[i] / 10.0, static_cast<double>(counts[i]) / loopnum, 0.01);
+		}
+
+		TEST_METHOD(TestWeightedUpdate)
+		{
+			// updates, removes and inserts keep the tree in sync with the weights
+
+			WeightedSampler sampler;
+			Random random(99);
+			std::vector<double> weights;
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				weights.push_back(random.RangeFloat(0.0f, 10.0f));
+				sampler.Insert(weights.back());
+			}
+
+			for (int i = 0; i < 10000; ++i)
+			{
+				int index = random.RangeInt(0, 999);
+
+				weights[index] = random.RangeFloat(0.0f, 10.0f);
+				sampler.SetWeight(index, weights[index]);
+			}
+
+			double total = 0.0;
+
+			for (int i = 0; i < 1000; ++i)
+				total += weights[i];
+
+			Assert::AreEqual(total, sampler.GetTotal(), 1e-6);
+
+			// removed indices are reused, the others stay
+
+			sampler.Remove(10);
+			sampler.Remove(500);
+			Assert::AreEqual(998, sampler.GetCount());
+			Assert::AreEqual(0.0, sampler.GetWeight(10));
+			Assert::AreEqual(total - weights[10] - weights[500], sampler.GetTotal(), 1e-6);
+
+			for (int i = 0; i < 10000; ++i)
+			{
+				int index = sampler.Sample(random);
+				Assert::IsTrue((index != 10) && (index != 500));
+			}
+
+			int first = sampler.Insert(1.0);
+			int second = sampler.Insert(1.0);
+			Assert::IsTrue(((first == 500) && (second == 10)) || ((first == 10) && (second == 500)));
+			Assert::AreEqual(1000, sampler.Insert(1.0));
+
+			// a reused index is live again, it can be updated and removed once more
+
+			sampler.SetWeight(first, 2.0);
+			sampler.Remove(first);
+			Assert::AreEqual(first, sampler.Insert(3.0));
+			Assert::AreEqual(3.0, sampler.GetWeight(first));
+
+			double before = sampler.GetTotal();
+			sampler.Rebuild();
+			Assert::AreEqual(before, sampler.GetTotal(), 1e-6);
+		}
+
+		TEST_METHOD(TestWeightedFill)
+		{
+			// bulk fill gives the same indices as Sample
+
+			WeightedSampler sampler;
+
+			for (int i = 0; i < 100; ++i)
+				sampler.Insert(static_cast<double>(i % 7));
+
+			const int count = 1000;
+			Random random_single(7);
+			Random random_bulk(7);
+			std::vector<int> indices(count);
+
+			sampler.Fill(random_bulk, &indices[0], count);
+
+			for (int i = 0; i < count; ++i)
+				Assert::AreEqual(sampler.Sample(random_single), indices[i]);
+		}
+
+		TEST_METHOD(TestWeightedThroughput)
+		{
+			// log ns per (update + sample) for 16 to 1M items, next to a linear scan for small sets
+
+			typedef std::chrono::high_resolution_clock Clock;
+
+			int sizes[6] = { 16, 256, 4096, 65536, 262144, 1048576 };
+			const int loopnum = 1000000;
+			Random random(5);
+			long long checksum = 0;
+
+			for (int k = 0; k < 6; ++k)
+			{
+				int size = sizes[k];
+				WeightedSampler sampler;
+				std::vector<float> weights(size);
+
+				sampler.Reserve(size);
+
+				for (int i = 0; i < size; ++i)
+				{
+					weights[i] = random.RangeFloat(0.0f, 1.0f);
+					sampler.Insert(weights[i]);
+				}
+
+				// the same updates for both
+
+				std::vector<int> indices(1024);
+				std::vector<float> values(1024);
+				random.FillInt(&indices[0], 1024, 0, size - 1);
+				random.FillFloat(&values[0], 1024, 0.0f, 1.0f);
+
+				Clock::time_point start = Clock::now();
+
+				for (int i = 0; i < loopnum; ++i)
+				{
+					sampler.SetWeight(indices[i & 1023], values[i & 1023]);
+					checksum += sampler.Sample(random);
+				}
+
+				double tree = std::chrono::duration<double>(Clock::now() - start).count();
+				double scan = 0.0;
+
+				if (size <= 4096)
+				{
+					int scan_loops = loopnum / 16;
+
+					start = Clock::now();
+
+					for (int i = 0; i < scan_loops; ++i)
+					{
+						weights[indices[i & 1023]] = values[i & 1023];
+
+						float total = 0.0f;
+
+						for (int j = 0; j < size; ++j)
+							total += weights[j];
+
+						float target = random.RangeFloat(0.0f, total);
+						int index = 0;
+
+						while ((index < size - 1) && (target >= weights[index]))
+							target -= weights[index++];
+
+						checksum += index;
+					}
+
+					scan = std::chrono::duration<double>(Clock::now() - start).count() / scan_loops * loopnum;
+				}
+
+				char output[128];
+
+				if (scan > 0.0)
+					sprintf_s(output, "%d items: %.1f ns/op (linear scan %.1f ns/op)\n", size, tree / loopnum * 1e9, scan / loopnum * 1e9);
+				else
+					sprintf_s(output, "%d items: %.1f ns/op\n", size, tree / loopnum * 1e9);
+
+				Logger::WriteMessage(output);
+			}
+
+			Assert::IsTrue(checksum > 0);
+		}
+	};
+}
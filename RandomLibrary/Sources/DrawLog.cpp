@@ -0,0 +1,476 @@
+/******************************************************************************/
+/*!
+\file		DrawLog.cpp
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Memory-mapped log of Random draws for record and replay.
+			Only a window of the file is mapped at a time, so logs of
+			billions of draws never have to fit in memory.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "DrawLog.h"
+#include "MyAssert.h"
+
+// static variables
+
+// view offsets must be a multiple of the allocation granularity
+static const unsigned long long DRAWLOG_GRANULARITY = 64ull * 1024ull;
+
+static const unsigned int DRAWLOG_MAGIC = 0x4C444E52;		// "RNDL"
+static const unsigned int DRAWLOG_VERSION = 1;
+
+// file header (32 bytes), count is 0 until the log is closed
+struct DrawLogHeader
+{
+	unsigned int magic;
+	unsigned int version;
+	unsigned int record_size;
+	unsigned int reserved;
+	unsigned long long count;
+	unsigned long long reserved2;
+};
+
+// helper functions
+
+/*--------------------------------------------------------------------------*
+Name:           RecordOffset
+
+Description:    File offset of a record.
+
+Arguments:      index:					record index.
+
+Returns:        unsigned long long:		Offset in bytes.
+*---------------------------------------------------------------------------*/
+static inline unsigned long long RecordOffset(unsigned long long index)
+{
+	return sizeof(DrawLogHeader) + index * sizeof(DrawRecord);
+}
+
+static inline DWORD High32(unsigned long long value)	{ return static_cast<DWORD>(value >> 32); }
+static inline DWORD Low32(unsigned long long value)		{ return static_cast<DWORD>(value & 0xFFFFFFFFull); }
+
+// public functions
+
+/*--------------------------------------------------------------------------*
+Name:           DrawLog
+
+Description:    Constructor.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+DrawLog::DrawLog() : m_mode(DRAWLOG_CLOSED), m_file(NULL), m_mapping(NULL),
+	m_view(NULL), m_view_begin(0), m_view_end(0), m_file_size(0), m_count(0), m_position(0)
+{
+}
+
+/*--------------------------------------------------------------------------*
+Name:           ~DrawLog
+
+Description:    Destructor, closes the file.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+DrawLog::~DrawLog()
+{
+	Close();
+}
+
+/*--------------------------------------------------------------------------*
+Name:           SetPosition
+
+Description:    Set the index of the next record to replay.
+
+Arguments:      position:	record index.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void DrawLog::SetPosition(unsigned long long position)
+{
+	ASSERT_MSG(position <= m_count, "Draw log position is out of range");
+
+	m_position = position;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Create
+
+Description:    Create (or truncate) a log file and start recording.
+
+Arguments:      filename:	path of the log file.
+
+Returns:        bool:		True if the file was created.
+*---------------------------------------------------------------------------*/
+bool DrawLog::Create(const char *filename)
+{
+	Close();
+
+	HANDLE file = CreateFileA(filename, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL,
+		CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	m_file = file;
+	m_mode = DRAWLOG_RECORD;
+	m_file_size = sizeof(DrawLogHeader);
+	m_count = 0;
+	m_position = 0;
+
+	// the header keeps count 0 until Close, so a crashed run is recovered on Open
+
+	if (!WriteHeader())
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Open
+
+Description:    Open an existing log file and start replaying from the first record.
+
+Arguments:      filename:	path of the log file.
+
+Returns:        bool:		True if the file is a valid log.
+*---------------------------------------------------------------------------*/
+bool DrawLog::Open(const char *filename)
+{
+	Close();
+
+	// share write access so the log of a running (or crashed) process can be inspected
+
+	HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	m_file = file;
+
+	LARGE_INTEGER size;
+	DrawLogHeader header;
+	DWORD bytes_read = 0;
+
+	if (!GetFileSizeEx(file, &size) ||
+		!ReadFile(file, &header, sizeof(header), &bytes_read, NULL) ||
+		(bytes_read != sizeof(header)) ||
+		(header.magic != DRAWLOG_MAGIC) ||
+		(header.version != DRAWLOG_VERSION) ||
+		(header.record_size != sizeof(DrawRecord)))
+	{
+		Close();
+		return false;
+	}
+
+	m_mode = DRAWLOG_REPLAY;
+	m_file_size = static_cast<unsigned long long>(size.QuadPart);
+	m_count = (m_file_size - sizeof(DrawLogHeader)) / sizeof(DrawRecord);
+	m_position = 0;
+
+	if (m_count == 0)
+		return true;
+
+	// a file mapping cannot be created for an empty file, so map only when there are records
+
+	m_mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+	if (!m_mapping)
+	{
+		Close();
+		return false;
+	}
+
+	m_count = (header.count != 0) ? header.count : RecoverCount();
+
+	return true;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Close
+
+Description:    Finish the log. When recording, the record count is written
+				and the file is trimmed to the last record.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void DrawLog::Close(void)
+{
+	Unmap();
+
+	if (m_mapping)
+	{
+		CloseHandle(m_mapping);
+		m_mapping = NULL;
+	}
+
+	if (m_file)
+	{
+		if (m_mode == DRAWLOG_RECORD)
+		{
+			LARGE_INTEGER end;
+			end.QuadPart = static_cast<long long>(RecordOffset(m_count));
+
+			SetFilePointerEx(m_file, end, NULL, FILE_BEGIN);
+			SetEndOfFile(m_file);
+			WriteHeader();
+		}
+
+		CloseHandle(m_file);
+		m_file = NULL;
+	}
+
+	m_mode = DRAWLOG_CLOSED;
+	m_file_size = 0;
+	m_count = 0;
+	m_position = 0;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Append
+
+Description:    Append one record (record mode).
+
+Arguments:      record:	draw to append.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void DrawLog::Append(const DrawRecord &record)
+{
+	ASSERT_MSG(m_mode == DRAWLOG_RECORD, "Draw log is not recording");
+
+	DrawRecord *slot = RecordAt(m_count);
+
+	ASSERT_MSG(slot, "Can't map draw log file");
+
+	if (slot)
+	{
+		*slot = record;
+		slot->flags |= DRAWLOG_FLAG_VALID;
+		++m_count;
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Next
+
+Description:    Read the next record (replay mode).
+
+Arguments:      record:	draw that was read.
+
+Returns:        bool:	False at the end of the log.
+*---------------------------------------------------------------------------*/
+bool DrawLog::Next(DrawRecord &record)
+{
+	if (!Read(m_position, record))
+		return false;
+
+	++m_position;
+
+	return true;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Read
+
+Description:    Read any record (replay mode).
+
+Arguments:      index:	record index.
+				record:	draw that was read.
+
+Returns:        bool:	False if index is past the end of the log.
+*---------------------------------------------------------------------------*/
+bool DrawLog::Read(unsigned long long index, DrawRecord &record)
+{
+	ASSERT_MSG(m_mode == DRAWLOG_REPLAY, "Draw log is not replaying");
+
+	if (index >= m_count)
+		return false;
+
+	const DrawRecord *slot = RecordAt(index);
+
+	if (!slot)
+		return false;
+
+	record = *slot;
+
+	return true;
+}
+
+// private functions
+
+/*--------------------------------------------------------------------------*
+Name:           RecordAt
+
+Description:    Pointer to a record, maps the window that holds it when needed.
+
+Arguments:      index:			record index.
+
+Returns:        DrawRecord*:	Record in the mapped window (NULL on failure).
+*---------------------------------------------------------------------------*/
+DrawRecord *DrawLog::RecordAt(unsigned long long index)
+{
+	unsigned long long offset = RecordOffset(index);
+
+	if ((offset < m_view_begin) || (offset + sizeof(DrawRecord) > m_view_end))
+	{
+		if (!MapWindow(offset))
+			return NULL;
+	}
+
+	return reinterpret_cast<DrawRecord *>(m_view + (offset - m_view_begin));
+}
+
+/*--------------------------------------------------------------------------*
+Name:           MapWindow
+
+Description:    Map DRAWLOG_WINDOW_SIZE bytes of the file starting at the
+				granularity boundary at or before offset. When recording past
+				the end of the file, the file is grown by the mapping.
+
+Arguments:      offset:	file offset that must be inside the window.
+
+Returns:        bool:	True if the window is mapped.
+*---------------------------------------------------------------------------*/
+bool DrawLog::MapWindow(unsigned long long offset)
+{
+	Unmap();
+
+	unsigned long long begin = offset - (offset % DRAWLOG_GRANULARITY);
+	unsigned long long end = begin + DRAWLOG_WINDOW_SIZE;
+	bool is_record = (m_mode == DRAWLOG_RECORD);
+
+	if (is_record)
+	{
+		// a mapping can't be resized, recreate it with the bigger file size
+
+		if (end > m_file_size)
+		{
+			if (m_mapping)
+			{
+				CloseHandle(m_mapping);
+				m_mapping = NULL;
+			}
+
+			m_file_size = end;
+		}
+	}
+	else if (end > m_file_size)
+	{
+		end = m_file_size;
+	}
+
+	if (offset + sizeof(DrawRecord) > end)
+		return false;
+
+	if (!m_mapping)
+	{
+		m_mapping = CreateFileMappingA(m_file, NULL, is_record ? PAGE_READWRITE : PAGE_READONLY,
+			High32(m_file_size), Low32(m_file_size), NULL);
+
+		if (!m_mapping)
+			return false;
+	}
+
+	void *view = MapViewOfFile(m_mapping, is_record ? FILE_MAP_WRITE : FILE_MAP_READ,
+		High32(begin), Low32(begin), static_cast<SIZE_T>(end - begin));
+
+	if (!view)
+		return false;
+
+	m_view = static_cast<unsigned char *>(view);
+	m_view_begin = begin;
+	m_view_end = end;
+
+	return true;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Unmap
+
+Description:    Unmap the current window.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void DrawLog::Unmap(void)
+{
+	if (m_view)
+	{
+		UnmapViewOfFile(m_view);
+		m_view = NULL;
+	}
+
+	m_view_begin = 0;
+	m_view_end = 0;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           WriteHeader
+
+Description:    Write the file header at the start of the file.
+
+Arguments:      None.
+
+Returns:        bool:	True if the header was written.
+*---------------------------------------------------------------------------*/
+bool DrawLog::WriteHeader(void)
+{
+	DrawLogHeader header = {};
+	header.magic = DRAWLOG_MAGIC;
+	header.version = DRAWLOG_VERSION;
+	header.record_size = sizeof(DrawRecord);
+	header.count = m_count;
+
+	LARGE_INTEGER start;
+	start.QuadPart = 0;
+	DWORD bytes_written = 0;
+
+	return SetFilePointerEx(m_file, start, NULL, FILE_BEGIN) &&
+		WriteFile(m_file, &header, sizeof(header), &bytes_written, NULL) &&
+		(bytes_written == sizeof(header));
+}
+
+/*--------------------------------------------------------------------------*
+Name:           RecoverCount
+
+Description:    Find the record count of a log that was not closed.
+				Records are written in order into a zero-filled file, so the
+				first record without DRAWLOG_FLAG_VALID is found by binary search.
+
+Arguments:      None.
+
+Returns:        unsigned long long:	Number of valid records.
+*---------------------------------------------------------------------------*/
+unsigned long long DrawLog::RecoverCount(void)
+{
+	unsigned long long low = 0;
+	unsigned long long high = m_count;
+
+	while (low < high)
+	{
+		unsigned long long middle = low + (high - low) / 2;
+		const DrawRecord *slot = RecordAt(middle);
+
+		if (slot && (slot->flags & DRAWLOG_FLAG_VALID))
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	return low;
+}
\ No newline at end of file
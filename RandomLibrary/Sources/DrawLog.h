@@ -0,0 +1,141 @@
+/******************************************************************************/
+/*!
+\file		DrawLog.h
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Memory-mapped log of Random draws for record and replay.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+#include "RandomStats.h"
+
+// static variables
+
+// bytes of the log file mapped at a time (multiple of the 64 KB allocation granularity)
+static const unsigned long long DRAWLOG_WINDOW_SIZE = 16ull * 1024ull * 1024ull;
+
+// DrawRecord flags
+static const unsigned char DRAWLOG_FLAG_CLAMP = 0x01;		// NormalRange is_clamp
+static const unsigned char DRAWLOG_FLAG_MINMAX = 0x02;		// NormalRange calculate_minmax
+static const unsigned char DRAWLOG_FLAG_VALID = 0x80;		// set on every written record
+
+enum DrawLogMode
+{
+	DRAWLOG_CLOSED,
+	DRAWLOG_RECORD,
+	DRAWLOG_REPLAY
+};
+
+// argument or result of a draw
+union DrawValue
+{
+	int i;
+	float f;
+	unsigned int u;
+};
+
+// one draw (24 bytes)
+struct DrawRecord
+{
+	unsigned char api;			// RandomApi
+	unsigned char flags;		// DRAWLOG_FLAG_*
+	unsigned short reserved;
+	DrawValue args[4];			// arguments in declaration order
+	DrawValue result;
+};
+
+// helpers to build DrawValue
+inline DrawValue DrawInt(int i)			{ DrawValue value; value.i = i; return value; }
+inline DrawValue DrawFloat(float f)		{ DrawValue value; value.f = f; return value; }
+
+class DrawLog
+{
+public:
+
+	/* constructor/destructor */
+
+	// constructor
+	DrawLog();
+
+	// destructor (closes the file)
+	~DrawLog();
+
+	/* getter/setter */
+
+	DrawLogMode GetMode(void) const				{ return m_mode; }
+
+	// number of records written (record) or stored in the file (replay)
+	unsigned long long GetCount(void) const		{ return m_count; }
+
+	// index of the next record to replay
+	unsigned long long GetPosition(void) const	{ return m_position; }
+	void SetPosition(unsigned long long position);
+
+	/* methods */
+
+	// create (or truncate) a log file and start recording
+	bool Create(const char *filename);
+
+	// open an existing log file and start replaying
+	bool Open(const char *filename);
+
+	// finish the log (record count is written on close)
+	void Close(void);
+
+	// append one record (record mode)
+	void Append(const DrawRecord &record);
+
+	// read the next record (replay mode), returns false at the end of the log
+	bool Next(DrawRecord &record);
+
+	// read any record (replay mode)
+	bool Read(unsigned long long index, DrawRecord &record);
+
+private:
+
+	// not copyable (owns the file)
+	DrawLog(const DrawLog &rhs);
+	DrawLog &operator=(const DrawLog &rhs);
+
+	/* helper functions */
+
+	// pointer to a record, maps the window that holds it when needed
+	DrawRecord *RecordAt(unsigned long long index);
+
+	// map the window that starts at or before offset
+	bool MapWindow(unsigned long long offset);
+
+	// unmap the current window
+	void Unmap(void);
+
+	// write the file header
+	bool WriteHeader(void);
+
+	// find the record count of a log that was not closed (e.g. crash)
+	unsigned long long RecoverCount(void);
+
+	/* variables */
+
+	DrawLogMode m_mode;
+
+	// file and mapping handles
+	void *m_file;
+	void *m_mapping;
+
+	// mapped window [m_view_begin, m_view_end) of the file
+	unsigned char *m_view;
+	unsigned long long m_view_begin;
+	unsigned long long m_view_end;
+
+	// current size of the file (grown a window at a time when recording)
+	unsigned long long m_file_size;
+
+	unsigned long long m_count;
+	unsigned long long m_position;
+};
\ No newline at end of file
@@ -0,0 +1,223 @@
+/******************************************************************************/
+/*!
+\file		FloatBits.h
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Uniform float, double and half numbers built from random bits.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+#include <cstring>
+
+// which ends of [0, 1] a unit number can take
+enum RandomInterval
+{
+	RANDOM_CLOSED_OPEN,			// [0, 1)
+	RANDOM_OPEN_CLOSED,			// (0, 1]
+	RANDOM_OPEN_OPEN			// (0, 1)
+};
+
+/*
+	A unit number is k / 2^n with k made of the top n random bits (n = 24
+	for float, 53 for double, 11 for half), which every format holds exactly,
+	so nothing rounds onto an end:
+		[0, 1)		k
+		(0, 1]		k + 1
+		(0, 1)		k with the lowest bit set (odd multiples of 2^-n, one bit less)
+
+	This gives 2^n evenly spaced numbers, one bit more than filling the
+	mantissa of [1, 2) and subtracting 1. Numbers below 2^-n (and most of the
+	ones near 0) never come out; Random's full precision mode draws the
+	exponent as well for that.
+*/
+
+/*--------------------------------------------------------------------------*
+Name:           UnitFloatFromBits
+
+Description:    Uniform float from the top 24 bits of a word.
+
+Arguments:      bits:		random word.
+				interval:	ends that can come out.
+
+Returns:        float:		Random number in interval.
+*---------------------------------------------------------------------------*/
+inline float UnitFloatFromBits(unsigned int bits, RandomInterval interval)
+{
+	unsigned int k = bits >> 8;
+
+	if (interval == RANDOM_OPEN_CLOSED)
+		k += 1;
+	else if (interval == RANDOM_OPEN_OPEN)
+		k |= 1;
+
+	return static_cast<float>(static_cast<int>(k)) * (1.0f / 16777216.0f);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           UnitDoubleFromBits
+
+Description:    Uniform double from the top 53 bits of a 64-bit word.
+
+Arguments:      bits:		random word.
+				interval:	ends that can come out.
+
+Returns:        double:		Random number in interval.
+*---------------------------------------------------------------------------*/
+inline double UnitDoubleFromBits(unsigned long long bits, RandomInterval interval)
+{
+	unsigned long long k = bits >> 11;
+
+	if (interval == RANDOM_OPEN_CLOSED)
+		k += 1;
+	else if (interval == RANDOM_OPEN_OPEN)
+		k |= 1;
+
+	return static_cast<double>(static_cast<long long>(k)) * (1.0 / 9007199254740992.0);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           FloatToHalf
+
+Description:    IEEE 754 half (binary16) nearest to a float, ties to even.
+				Out of range numbers become infinity.
+
+Arguments:      value:				number to convert.
+
+Returns:        unsigned short:		Half bits.
+*---------------------------------------------------------------------------*/
+inline unsigned short FloatToHalf(float value)
+{
+	unsigned int bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	unsigned int sign = (bits >> 16) & 0x8000;
+	unsigned int magnitude = bits & 0x7FFFFFFF;
+
+	// infinity and NaN (kept quiet)
+
+	if (magnitude >= 0x7F800000)
+		return static_cast<unsigned short>(sign | 0x7C00 | ((magnitude > 0x7F800000) ? 0x0200 : 0));
+
+	// 2^16 and up, past the largest half (65504) even after rounding
+
+	if (magnitude >= 0x47800000)
+		return static_cast<unsigned short>(sign | 0x7C00);
+
+	// 2^-25 and below round to 0
+
+	if (magnitude <= 0x33000000)
+		return static_cast<unsigned short>(sign);
+
+	unsigned int half;
+	unsigned int rest;
+	unsigned int halfway;
+
+	if (magnitude < 0x38800000)
+	{
+		// below 2^-14, subnormal half of 2^-24 steps
+
+		int shift = 126 - static_cast<int>(magnitude >> 23);
+		unsigned int mantissa = (magnitude & 0x7FFFFF) | 0x800000;
+
+		half = mantissa >> shift;
+		rest = mantissa & ((1u << shift) - 1);
+		halfway = 1u << (shift - 1);
+	}
+	else
+	{
+		// rebias the exponent, rounding carries into it (up to infinity)
+
+		half = (magnitude - 0x38000000) >> 13;
+		rest = magnitude & 0x1FFF;
+		halfway = 0x1000;
+	}
+
+	if ((rest > halfway) || ((rest == halfway) && (half & 1)))
+		++half;
+
+	return static_cast<unsigned short>(sign | half);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           HalfToFloat
+
+Description:    Float of an IEEE 754 half (binary16), exact.
+
+Arguments:      half:		half bits.
+
+Returns:        float:		Number.
+*---------------------------------------------------------------------------*/
+inline float HalfToFloat(unsigned short half)
+{
+	unsigned int sign = static_cast<unsigned int>(half & 0x8000) << 16;
+	unsigned int exponent = (half >> 10) & 0x1F;
+	unsigned int mantissa = half & 0x3FF;
+	unsigned int bits;
+
+	if (exponent == 0)
+	{
+		float value = static_cast<float>(static_cast<int>(mantissa)) * (1.0f / 16777216.0f);
+
+		return sign ? -value : value;
+	}
+
+	if (exponent == 31)
+		bits = sign | 0x7F800000 | (mantissa << 13);
+	else
+		bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+
+	float value;
+	std::memcpy(&value, &bits, sizeof(value));
+
+	return value;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           UnitHalfFromBits
+
+Description:    Uniform half from the top 11 bits of a word.
+
+Arguments:      bits:				random word.
+				interval:			ends that can come out.
+
+Returns:        unsigned short:		Half bits of a random number in interval.
+*---------------------------------------------------------------------------*/
+inline unsigned short UnitHalfFromBits(unsigned int bits, RandomInterval interval)
+{
+	unsigned int k = bits >> 21;
+
+	if (interval == RANDOM_OPEN_CLOSED)
+		k += 1;
+	else if (interval == RANDOM_OPEN_OPEN)
+		k |= 1;
+
+	return FloatToHalf(static_cast<float>(static_cast<int>(k)) * (1.0f / 2048.0f));
+}
+
+/*--------------------------------------------------------------------------*
+Name:           HalfStep
+
+Description:    Next half toward +infinity (is_up) or -infinity.
+
+Arguments:      half:				half bits (finite).
+				is_up:				direction.
+
+Returns:        unsigned short:		Half bits of the neighbour.
+*---------------------------------------------------------------------------*/
+inline unsigned short HalfStep(unsigned short half, bool is_up)
+{
+	bool is_negative = (half & 0x8000) != 0;
+
+	// -0 and +0 step to the smallest subnormal of the other sign
+
+	if ((half & 0x7FFF) == 0)
+		return is_up ? 0x0001 : 0x8001;
+
+	return static_cast<unsigned short>((is_up != is_negative) ? (half + 1) : (half - 1));
+}
@@ -15,4 +15,9 @@ written consent of DigiPen Institute of Technology is prohibited.
 
 #include "Singleton.h"
 
-#define g_random Singleton<Random>::GetInstance()
\ No newline at end of file
+#ifdef RANDOM_INSTRUMENTATION
+// attribute every evaluation of g_random to its source line
+#define g_random Singleton<Random>::GetInstance().AtCallSite(__FILE__, __LINE__)
+#else
+#define g_random Singleton<Random>::GetInstance()
+#endif
\ No newline at end of file
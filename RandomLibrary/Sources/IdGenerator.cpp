@@ -0,0 +1,386 @@
+/******************************************************************************/
+/*!
+\file		IdGenerator.cpp
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Random identifiers and tokens (UUIDv4, hex, base32, base62, 64/128-bit).
+			Random words are pulled in blocks and encoded with lookup tables
+			(SSE2 for hex), nothing is allocated on the heap.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <cstring>
+
+#include "IdGenerator.h"
+#include "SIMD.h"
+
+// static variables
+
+static const char HEX_DIGITS[] = "0123456789abcdef";
+static const char BASE32_DIGITS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+static const char BASE62_DIGITS[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+// random bytes of a UUID
+static const int UUID_BYTES = 16;
+
+// helper functions
+
+/*--------------------------------------------------------------------------*
+Name:           HexEncode
+
+Description:    Encode bytes as lowercase hex, high nibble first.
+				16 bytes at a time with SSE2.
+
+Arguments:      bytes:	bytes to encode.
+				count:	number of bytes.
+				output:	buffer of at least count * 2 chars.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+static void HexEncode(const unsigned char *bytes, int count, char *output)
+{
+	int i = 0;
+
+#ifdef RANDOM_USE_SSE2
+	const __m128i low_mask = _mm_set1_epi8(0x0F);
+	const __m128i nine = _mm_set1_epi8(9);
+	const __m128i zero_char = _mm_set1_epi8('0');
+	const __m128i letter_offset = _mm_set1_epi8('a' - '0' - 10);
+
+	for (; i + 16 <= count; i += 16)
+	{
+		__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + i));
+		__m128i lo = _mm_and_si128(b, low_mask);
+		__m128i hi = _mm_and_si128(_mm_srli_epi16(b, 4), low_mask);
+
+		// interleave so the high nibble of each byte comes first
+
+		__m128i nibbles[2] = { _mm_unpacklo_epi8(hi, lo), _mm_unpackhi_epi8(hi, lo) };
+
+		for (int j = 0; j < 2; ++j)
+		{
+			__m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles[j], nine), letter_offset);
+			__m128i chars = _mm_add_epi8(_mm_add_epi8(nibbles[j], zero_char), letters);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(output + i * 2 + j * 16), chars);
+		}
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		output[i * 2] = HEX_DIGITS[bytes[i] >> 4];
+		output[i * 2 + 1] = HEX_DIGITS[bytes[i] & 0x0F];
+	}
+}
+
+// public functions
+
+/*--------------------------------------------------------------------------*
+Name:           IdGenerator
+
+Description:    Constructor. Nothing is drawn until the first identifier.
+
+Arguments:      random:	random number generator to draw from.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+IdGenerator::IdGenerator(Random &random) : m_random(random), m_next(ID_BUFFER_WORDS)
+{
+}
+
+/*--------------------------------------------------------------------------*
+Name:           ~IdGenerator
+
+Description:    Destructor.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+IdGenerator::~IdGenerator()
+{
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Uuid
+
+Description:    Random (version 4, variant 1) UUID string.
+
+Arguments:      output:	buffer of at least UUID_STRING_LENGTH + 1 chars.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void IdGenerator::Uuid(char *output)
+{
+	WriteUuid(output);
+	output[UUID_STRING_LENGTH] = '\0';
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Hex / Base32 / Base62
+
+Description:    Random token of length characters.
+
+Arguments:      output:	buffer of at least length + 1 chars.
+				length:	number of characters.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void IdGenerator::Hex(char *output, int length)
+{
+	WriteHex(output, length);
+	output[length] = '\0';
+}
+
+void IdGenerator::Base32(char *output, int length)
+{
+	WriteBase32(output, length);
+	output[length] = '\0';
+}
+
+void IdGenerator::Base62(char *output, int length)
+{
+	WriteBase62(output, length);
+	output[length] = '\0';
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Id64
+
+Description:    Random 64-bit identifier.
+
+Arguments:      None.
+
+Returns:        unsigned long long:		Identifier.
+*---------------------------------------------------------------------------*/
+unsigned long long IdGenerator::Id64(void)
+{
+	unsigned long long high = NextWord();
+	unsigned long long low = NextWord();
+
+	return (high << 32) | low;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Id128
+
+Description:    Random 128-bit identifier.
+
+Arguments:      None.
+
+Returns:        UInt128:	Identifier.
+*---------------------------------------------------------------------------*/
+UInt128 IdGenerator::Id128(void)
+{
+	UInt128 id;
+	id.high = Id64();
+	id.low = Id64();
+
+	return id;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Uuids
+
+Description:    count UUID strings, UUID_STRING_LENGTH chars each, no terminators.
+
+Arguments:      output:	buffer of at least count * UUID_STRING_LENGTH chars.
+				count:	number of UUIDs.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void IdGenerator::Uuids(char *output, int count)
+{
+	for (int i = 0; i < count; ++i)
+		WriteUuid(output + i * UUID_STRING_LENGTH);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Hexes / Base32s / Base62s
+
+Description:    count tokens of length chars each, no terminators.
+
+Arguments:      output:	buffer of at least count * length chars.
+				count:	number of tokens.
+				length:	characters per token.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void IdGenerator::Hexes(char *output, int count, int length)
+{
+	for (int i = 0; i < count; ++i)
+		WriteHex(output + i * length, length);
+}
+
+void IdGenerator::Base32s(char *output, int count, int length)
+{
+	for (int i = 0; i < count; ++i)
+		WriteBase32(output + i * length, length);
+}
+
+void IdGenerator::Base62s(char *output, int count, int length)
+{
+	for (int i = 0; i < count; ++i)
+		WriteBase62(output + i * length, length);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Id64s
+
+Description:    count random 64-bit identifiers.
+
+Arguments:      output:	buffer of at least count identifiers.
+				count:	number of identifiers.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void IdGenerator::Id64s(unsigned long long *output, int count)
+{
+	for (int i = 0; i < count; ++i)
+		output[i] = Id64();
+}
+
+// private functions
+
+/*--------------------------------------------------------------------------*
+Name:           NextWord
+
+Description:    Next random word, refills the buffer from Random when empty.
+
+Arguments:      None.
+
+Returns:        unsigned int:	32 random bits.
+*---------------------------------------------------------------------------*/
+unsigned int IdGenerator::NextWord(void)
+{
+	if (m_next == ID_BUFFER_WORDS)
+	{
+		m_random.FillRawBits(m_words, ID_BUFFER_WORDS);
+		m_next = 0;
+	}
+
+	return m_words[m_next++];
+}
+
+/*--------------------------------------------------------------------------*
+Name:           WriteUuid
+
+Description:    Write a version 4 UUID (UUID_STRING_LENGTH chars, no terminator).
+
+Arguments:      output:	buffer of at least UUID_STRING_LENGTH chars.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void IdGenerator::WriteUuid(char *output)
+{
+	unsigned int words[UUID_BYTES / 4];
+	unsigned char bytes[UUID_BYTES];
+	char hex[UUID_BYTES * 2];
+
+	for (int i = 0; i < UUID_BYTES / 4; ++i)
+		words[i] = NextWord();
+
+	memcpy(bytes, words, UUID_BYTES);
+
+	// version 4 (random) and variant 1 (RFC 4122)
+
+	bytes[6] = static_cast<unsigned char>((bytes[6] & 0x0F) | 0x40);
+	bytes[8] = static_cast<unsigned char>((bytes[8] & 0x3F) | 0x80);
+
+	HexEncode(bytes, UUID_BYTES, hex);
+
+	// 8-4-4-4-12
+
+	memcpy(output, hex, 8);
+	output[8] = '-';
+	memcpy(output + 9, hex + 8, 4);
+	output[13] = '-';
+	memcpy(output + 14, hex + 12, 4);
+	output[18] = '-';
+	memcpy(output + 19, hex + 16, 4);
+	output[23] = '-';
+	memcpy(output + 24, hex + 20, 12);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           WriteHex
+
+Description:    Write a lowercase hex token (no terminator), 4 bits per char.
+
+Arguments:      output:	buffer of at least length chars.
+				length:	number of characters.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void IdGenerator::WriteHex(char *output, int length)
+{
+	unsigned int words[4];
+	char hex[32];
+
+	for (int i = 0; i < length; i += 32)
+	{
+		// 8 chars per word, only draw the words the token needs
+
+		int count = (length - i < 32) ? (length - i) : 32;
+		int word_count = (count + 7) / 8;
+
+		for (int j = 0; j < word_count; ++j)
+			words[j] = NextWord();
+
+		HexEncode(reinterpret_cast<const unsigned char *>(words), word_count * 4, hex);
+		memcpy(output + i, hex, count);
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           WriteBase32
+
+Description:    Write a base32 token (no terminator), 6 chars per random word.
+
+Arguments:      output:	buffer of at least length chars.
+				length:	number of characters.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void IdGenerator::WriteBase32(char *output, int length)
+{
+	for (int i = 0; i < length;)
+	{
+		unsigned int word = NextWord();
+
+		for (int j = 0; (j < 6) && (i < length); ++j, word >>= 5)
+			output[i++] = BASE32_DIGITS[word & 31];
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           WriteBase62
+
+Description:    Write a base62 token (no terminator). Each random word gives
+				five 6-bit values, 62 and 63 are rejected to stay unbiased.
+
+Arguments:      output:	buffer of at least length chars.
+				length:	number of characters.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void IdGenerator::WriteBase62(char *output, int length)
+{
+	for (int i = 0; i < length;)
+	{
+		unsigned int word = NextWord();
+
+		for (int j = 0; (j < 5) && (i < length); ++j, word >>= 6)
+		{
+			unsigned int value = word & 63;
+
+			if (value < 62)
+				output[i++] = BASE62_DIGITS[value];
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+/******************************************************************************/
+/*!
+\file		IdGenerator.h
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Random identifiers and tokens (UUIDv4, hex, base32, base62, 64/128-bit).
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+#include "Random.h"
+
+// static variables
+
+// characters of a UUID string (8-4-4-4-12), without terminator
+static const int UUID_STRING_LENGTH = 36;
+
+// random words pulled from Random per refill
+static const int ID_BUFFER_WORDS = 64;
+
+// 128-bit identifier
+struct UInt128
+{
+	unsigned long long high;
+	unsigned long long low;
+};
+
+/*
+	Identifiers for game objects, save slots, log correlation and the like.
+
+	NOT for session secrets, passwords, API keys, nonces or any other
+	security token. Every word comes from Random's non-cryptographic engine,
+	whose state can be recovered from a few outputs, and Random() seeds it
+	with time(NULL), so anyone who knows roughly when the process started
+	can guess every identifier. Use the OS CSPRNG (e.g. BCryptGenRandom)
+	for those.
+*/
+class IdGenerator
+{
+public:
+
+	/* constructor/destructor */
+
+	// constructor (words are pulled from random a block at a time)
+	IdGenerator(Random &random);
+
+	// destructor
+	~IdGenerator();
+
+	/* methods */
+
+	// single identifiers, strings are null-terminated (buffer needs length + 1 chars)
+
+	// random (version 4) UUID, e.g. "1b4e28ba-2fa1-41d2-883f-0016d3cca427"
+	void Uuid(char *output);
+
+	// lowercase hex token
+	void Hex(char *output, int length);
+
+	// RFC 4648 base32 token (A-Z, 2-7)
+	void Base32(char *output, int length);
+
+	// base62 token (0-9, A-Z, a-z)
+	void Base62(char *output, int length);
+
+	// 64/128-bit identifiers
+	unsigned long long Id64(void);
+	UInt128 Id128(void);
+
+	// bulk identifiers, count fixed-size records back to back without terminators
+
+	void Uuids(char *output, int count);
+	void Hexes(char *output, int count, int length);
+	void Base32s(char *output, int count, int length);
+	void Base62s(char *output, int count, int length);
+	void Id64s(unsigned long long *output, int count);
+
+private:
+
+	// no assignment (holds a reference)
+	IdGenerator &operator=(const IdGenerator &rhs);
+
+	/* helper functions */
+
+	// next random word from the buffer
+	unsigned int NextWord(void);
+
+	// write length characters of each encoding (no terminator)
+	void WriteUuid(char *output);
+	void WriteHex(char *output, int length);
+	void WriteBase32(char *output, int length);
+	void WriteBase62(char *output, int length);
+
+	/* variables */
+
+	// random number generator to draw from
+	Random &m_random;
+
+	// buffered random words, m_words[m_next ~ ID_BUFFER_WORDS - 1] are unused
+	unsigned int m_words[ID_BUFFER_WORDS];
+	int m_next;
+};
\ No newline at end of file
@@ -0,0 +1,203 @@
+/******************************************************************************/
+/*!
+\file		InverseCdf.cpp
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Table-driven inverse CDF sampling of arbitrary continuous distributions.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "InverseCdf.h"
+#include "MyAssert.h"
+
+// public functions
+
+/*--------------------------------------------------------------------------*
+Name:           InverseCdf
+
+Description:    Constructor.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+InverseCdf::InverseCdf()
+{
+}
+
+/*--------------------------------------------------------------------------*
+Name:           ~InverseCdf
+
+Description:    Destructor.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+InverseCdf::~InverseCdf()
+{
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Build
+
+Description:    Build the table from tabulated points of a PDF.
+
+Arguments:      x:			point positions, ascending.
+				pdf:		density at each point (>= 0, need not be normalized).
+				count:		number of points (at least 2).
+				guide_size:	number of guide entries (<= 0 for one per point).
+
+Returns:        bool:		False if the points are not a distribution.
+*---------------------------------------------------------------------------*/
+bool InverseCdf::Build(const float *x, const float *pdf, int count, int guide_size)
+{
+	m_x.clear();
+	m_cdf.clear();
+	m_scale.clear();
+	m_guide.clear();
+
+	if (count < 2)
+		return false;
+
+	// integrate with trapezoids (in double, the sum of many small areas loses precision in float)
+
+	std::vector<double> cdf(count);
+	cdf[0] = 0.0;
+
+	for (int i = 1; i < count; ++i)
+	{
+		if ((x[i] < x[i - 1]) || (pdf[i] < 0.0f) || (pdf[i - 1] < 0.0f))
+			return false;
+
+		cdf[i] = cdf[i - 1] + 0.5 * (static_cast<double>(pdf[i - 1]) + pdf[i]) * (static_cast<double>(x[i]) - x[i - 1]);
+	}
+
+	double total = cdf[count - 1];
+
+	if (!(total > 0.0))
+		return false;
+
+	m_x.assign(x, x + count);
+	m_cdf.resize(count);
+	m_scale.resize(count - 1);
+
+	for (int i = 0; i < count; ++i)
+		m_cdf[i] = static_cast<float>(cdf[i] / total);
+
+	m_cdf[count - 1] = 1.0f;
+
+	// segments without probability are never selected, their scale stays 0
+
+	for (int i = 0; i < count - 1; ++i)
+	{
+		double mass = (cdf[i + 1] - cdf[i]) / total;
+
+		m_scale[i] = (mass > 0.0) ? static_cast<float>((static_cast<double>(x[i + 1]) - x[i]) / mass) : 0.0f;
+	}
+
+	// guide[k] is the segment holding probability k / guide_size
+
+	if (guide_size <= 0)
+		guide_size = count;
+
+	m_guide.resize(guide_size);
+
+	int segment = 0;
+
+	for (int k = 0; k < guide_size; ++k)
+	{
+		float u = static_cast<float>(k) / static_cast<float>(guide_size);
+
+		while ((segment < count - 2) && (m_cdf[segment + 1] <= u))
+			++segment;
+
+		m_guide[k] = segment;
+	}
+
+	return true;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           GetMemory
+
+Description:    Bytes used by the table.
+
+Arguments:      None.
+
+Returns:        size_t:		Table size in bytes.
+*---------------------------------------------------------------------------*/
+size_t InverseCdf::GetMemory(void) const
+{
+	return (m_x.size() + m_cdf.size() + m_scale.size()) * sizeof(float) + m_guide.size() * sizeof(int);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Sample
+
+Description:    Returns a random number of the distribution from one uniform draw.
+
+Arguments:      random:		random number generator to draw from.
+
+Returns:        float:		Random number of the distribution.
+*---------------------------------------------------------------------------*/
+float InverseCdf::Sample(Random &random) const
+{
+	return Quantile(random.RangeFloat(0.0f, 1.0f));
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Fill
+
+Description:    Fills output with count random numbers of the distribution.
+				Produces the same sequence as calling Sample count times.
+
+Arguments:      random:		random number generator to draw from.
+				output:		buffer of at least count values.
+				count:		number of values.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void InverseCdf::Fill(Random &random, float *output, int count) const
+{
+	random.FillFloat(output, count, 0.0f, 1.0f);
+
+	for (int i = 0; i < count; ++i)
+		output[i] = Quantile(output[i]);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Quantile
+
+Description:    Value of the distribution at cumulative probability u.
+
+Arguments:      u:			cumulative probability [0-1].
+
+Returns:        float:		Value at u.
+*---------------------------------------------------------------------------*/
+float InverseCdf::Quantile(float u) const
+{
+	ASSERT_MSG(IsBuilt(), "Inverse CDF table is not built");
+
+	int guide_size = static_cast<int>(m_guide.size());
+	int last = static_cast<int>(m_scale.size()) - 1;
+	int slice = static_cast<int>(u * static_cast<float>(guide_size));
+
+	// u of 1 (or rounding up to it) stays in the last slice
+
+	if (slice >= guide_size)
+		slice = guide_size - 1;
+	else if (slice < 0)
+		slice = 0;
+
+	int segment = m_guide[slice];
+
+	while ((segment < last) && (m_cdf[segment + 1] <= u))
+		++segment;
+
+	return m_x[segment] + (u - m_cdf[segment]) * m_scale[segment];
+}
@@ -0,0 +1,99 @@
+/******************************************************************************/
+/*!
+\file		InverseCdf.h
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Table-driven inverse CDF sampling of arbitrary continuous distributions.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "Random.h"
+
+// static variables
+
+// default number of points a PDF callable is evaluated at
+static const int DEFAULT_CDF_POINTS = 1024;
+
+/*
+	The PDF is integrated once into a piecewise-linear CDF (trapezoids between
+	the points), then a guide table maps each of guide_size equal slices of
+	[0, 1) to the first segment it can land in. Sampling is one RangeFloat,
+	a guide lookup, (on average) at most points / guide_size steps of search
+	and a linear interpolation.
+
+	Accuracy grows with points, speed with guide_size, memory is
+	12 bytes per point plus 4 bytes per guide entry.
+*/
+class InverseCdf
+{
+public:
+
+	/* constructor/destructor */
+
+	// constructor (empty table)
+	InverseCdf();
+
+	// destructor
+	~InverseCdf();
+
+	/* methods */
+
+	// build from tabulated points, x ascending and pdf >= 0 (need not be normalized)
+	// guide_size <= 0 uses one guide entry per point
+	// returns false (and leaves the table empty) if the points are not a distribution
+	bool Build(const float *x, const float *pdf, int count, int guide_size = 0);
+
+	// build from a PDF callable (float pdf(float x)) evaluated at points evenly spaced points of min~max
+	template <typename Function>
+	bool Build(Function pdf, float min, float max, int points = DEFAULT_CDF_POINTS, int guide_size = 0)
+	{
+		if (points < 2)
+			return false;
+
+		std::vector<float> x(points);
+		std::vector<float> density(points);
+
+		for (int i = 0; i < points; ++i)
+		{
+			x[i] = min + (max - min) * (static_cast<float>(i) / static_cast<float>(points - 1));
+			density[i] = static_cast<float>(pdf(x[i]));
+		}
+
+		return Build(&x[0], &density[0], points, guide_size);
+	}
+
+	// true once a table is built
+	bool IsBuilt(void) const								{ return !m_cdf.empty(); }
+
+	// bytes used by the table
+	size_t GetMemory(void) const;
+
+	// Returns a random number of the distribution (one uniform draw)
+	float Sample(Random &random) const;
+
+	// Fills output with count random numbers, same sequence as calling Sample count times
+	void Fill(Random &random, float *output, int count) const;
+
+	// value at cumulative probability u [0-1]
+	float Quantile(float u) const;
+
+private:
+
+	/* variables */
+
+	// point x, normalized CDF at x, and dx/dCDF of the segment starting at x
+	std::vector<float> m_x;
+	std::vector<float> m_cdf;
+	std::vector<float> m_scale;
+
+	// first segment of each equal slice of [0, 1)
+	std::vector<int> m_guide;
+};
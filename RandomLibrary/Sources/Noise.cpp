@@ -0,0 +1,1111 @@
+/******************************************************************************/
+/*!
+\file		Noise.cpp
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Coherent noise (value, Perlin, simplex) seeded from Random.
+			Perlin and simplex noise follow Stefan Gustavson's reference
+			implementations (noise1234 / simplexnoise1234).
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <algorithm>
+
+#include "Noise.h"
+#include "SIMD.h"
+#include "MyAssert.h"
+
+// static variables
+
+// skewing/unskewing factors for simplex noise
+static const float SIMPLEX_F2 = 0.366025403f;	// (sqrt(3) - 1) / 2
+static const float SIMPLEX_G2 = 0.211324865f;	// (3 - sqrt(3)) / 6
+static const float SIMPLEX_F3 = 0.333333333f;	// 1 / 3
+static const float SIMPLEX_G3 = 0.166666667f;	// 1 / 6
+static const float SIMPLEX_F4 = 0.309016994f;	// (sqrt(5) - 1) / 4
+static const float SIMPLEX_G4 = 0.138196601f;	// (5 - sqrt(5)) / 20
+
+// output scale of each noise so the result is roughly in [-1, 1]
+static const float PERLIN_SCALE_1D = 0.188f;
+static const float PERLIN_SCALE_2D = 0.507f;
+static const float PERLIN_SCALE_3D = 0.936f;
+static const float PERLIN_SCALE_4D = 0.87f;
+static const float SIMPLEX_SCALE_1D = 0.395f;
+static const float SIMPLEX_SCALE_2D = 40.0f;
+static const float SIMPLEX_SCALE_3D = 32.0f;
+static const float SIMPLEX_SCALE_4D = 27.0f;
+
+// samples computed per pass when building a fractal row
+static const int NOISE_ROW_CHUNK = 256;
+
+// helper functions
+
+/*--------------------------------------------------------------------------*
+Name:           FastFloor
+
+Description:    Floor a float to int without calling floorf.
+
+Arguments:      x:		value to floor.
+
+Returns:        int:	Largest integer not greater than x.
+*---------------------------------------------------------------------------*/
+static inline int FastFloor(float x)
+{
+	int i = static_cast<int>(x);
+
+	return (x < static_cast<float>(i)) ? (i - 1) : i;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Fade
+
+Description:    Quintic interpolation curve 6t^5 - 15t^4 + 10t^3.
+
+Arguments:      t:		interpolation value [0-1].
+
+Returns:        float:	Eased value.
+*---------------------------------------------------------------------------*/
+static inline float Fade(float t)
+{
+	return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Lerp
+
+Description:    Linear interpolation between a and b.
+
+Arguments:      t:		interpolation value [0-1].
+				a:		value at t = 0.
+				b:		value at t = 1.
+
+Returns:        float:	Interpolated value.
+*---------------------------------------------------------------------------*/
+static inline float Lerp(float t, float a, float b)
+{
+	return a + t * (b - a);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Grad1 / Grad2 / Grad3 / Grad4
+
+Description:    Dot product of the hashed gradient with the distance vector.
+
+Arguments:      hash:	hashed lattice value.
+				x~w:	distance from the lattice point.
+
+Returns:        float:	Gradient contribution.
+*---------------------------------------------------------------------------*/
+static inline float Grad1(int hash, float x)
+{
+	int h = hash & 15;
+	float grad = 1.0f + static_cast<float>(h & 7);
+
+	return ((h & 8) ? -grad : grad) * x;
+}
+
+static inline float Grad2(int hash, float x, float y)
+{
+	int h = hash & 7;
+	float u = (h < 4) ? x : y;
+	float v = (h < 4) ? y : x;
+
+	return ((h & 1) ? -u : u) + ((h & 2) ? -2.0f * v : 2.0f * v);
+}
+
+static inline float Grad3(int hash, float x, float y, float z)
+{
+	int h = hash & 15;
+	float u = (h < 8) ? x : y;
+	float v = (h < 4) ? y : ((h == 12) || (h == 14)) ? x : z;
+
+	return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
+}
+
+static inline float Grad4(int hash, float x, float y, float z, float w)
+{
+	int h = hash & 31;
+	float u = (h < 24) ? x : y;
+	float v = (h < 16) ? y : z;
+	float s = (h < 8) ? z : w;
+
+	return ((h & 1) ? -u : u) + ((h & 2) ? -v : v) + ((h & 4) ? -s : s);
+}
+
+#ifdef RANDOM_USE_SSE2
+
+// SSE2 versions of the helpers above, 4 samples per call
+// each operation matches the scalar order so both paths agree
+
+static inline __m128i FastFloor4(__m128 x)
+{
+	__m128i i = _mm_cvttps_epi32(x);
+	__m128 below = _mm_cmplt_ps(x, _mm_cvtepi32_ps(i));
+
+	// the compare mask is -1 where truncation rounded up
+	return _mm_add_epi32(i, _mm_castps_si128(below));
+}
+
+static inline __m128 Fade4(__m128 t)
+{
+	__m128 inner = _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f))), _mm_set1_ps(10.0f));
+
+	return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), inner);
+}
+
+static inline __m128 Lerp4(__m128 t, __m128 a, __m128 b)
+{
+	return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+}
+
+static inline __m128 Select4(__m128i mask, __m128 a, __m128 b)
+{
+	__m128 m = _mm_castsi128_ps(mask);
+
+	return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+}
+
+static inline __m128 FlipSign4(__m128i hash, int bit, __m128 x)
+{
+	// move the selected hash bit into the float sign bit
+	__m128i sign = _mm_and_si128(hash, _mm_set1_epi32(bit));
+	sign = _mm_slli_epi32(_mm_cmpeq_epi32(sign, _mm_set1_epi32(bit)), 31);
+
+	return _mm_xor_ps(x, _mm_castsi128_ps(sign));
+}
+
+static inline __m128 Grad2_4(__m128i hash, __m128 x, __m128 y)
+{
+	__m128i h = _mm_and_si128(hash, _mm_set1_epi32(7));
+	__m128i lt4 = _mm_cmplt_epi32(h, _mm_set1_epi32(4));
+	__m128 u = Select4(lt4, x, y);
+	__m128 v = Select4(lt4, y, x);
+
+	return _mm_add_ps(FlipSign4(h, 1, u), FlipSign4(h, 2, _mm_mul_ps(_mm_set1_ps(2.0f), v)));
+}
+
+static inline __m128 Grad3_4(__m128i hash, __m128 x, __m128 y, __m128 z)
+{
+	__m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+	__m128i lt8 = _mm_cmplt_epi32(h, _mm_set1_epi32(8));
+	__m128i lt4 = _mm_cmplt_epi32(h, _mm_set1_epi32(4));
+	__m128i is_x = _mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)), _mm_cmpeq_epi32(h, _mm_set1_epi32(14)));
+	__m128 u = Select4(lt8, x, y);
+	__m128 v = Select4(lt4, y, Select4(is_x, x, z));
+
+	return _mm_add_ps(FlipSign4(h, 1, u), FlipSign4(h, 2, v));
+}
+
+#endif
+
+// public functions
+
+/*--------------------------------------------------------------------------*
+Name:           Noise
+
+Description:    Constructor, builds the tables from the random stream.
+
+Arguments:      random:	random number generator to draw the tables from.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+Noise::Noise(Random &random)
+{
+	Reseed(random);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           ~Noise
+
+Description:    Destructor.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+Noise::~Noise()
+{
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Reseed
+
+Description:    Rebuild permutation and value tables from the random stream.
+				The same seed always produces the same noise.
+
+Arguments:      random:	random number generator to draw the tables from.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Noise::Reseed(Random &random)
+{
+	for (int i = 0; i < NOISE_TABLE_SIZE; ++i)
+		m_perm[i] = static_cast<unsigned char>(i);
+
+	// Fisher-Yates shuffle
+
+	for (int i = NOISE_TABLE_SIZE - 1; i > 0; --i)
+		std::swap(m_perm[i], m_perm[random.RangeInt(0, i)]);
+
+	for (int i = 0; i < NOISE_TABLE_SIZE; ++i)
+	{
+		m_perm[i + NOISE_TABLE_SIZE] = m_perm[i];
+		m_values[i] = random.RangeFloat(-1.0f, 1.0f);
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Value1D / Value2D / Value3D
+
+Description:    Returns value noise, lattice values interpolated with quintic curve.
+
+Arguments:      x~z:	sample position.
+
+Returns:        float:	Noise value [-1, 1].
+*---------------------------------------------------------------------------*/
+float Noise::Value1D(float x)
+{
+	int ix0 = FastFloor(x);
+	float s = Fade(x - static_cast<float>(ix0));
+	int ix1 = (ix0 + 1) & 0xff;
+	ix0 &= 0xff;
+
+	return Lerp(s, m_values[m_perm[ix0]], m_values[m_perm[ix1]]);
+}
+
+float Noise::Value2D(float x, float y)
+{
+	int ix0 = FastFloor(x);
+	int iy0 = FastFloor(y);
+	float s = Fade(x - static_cast<float>(ix0));
+	float t = Fade(y - static_cast<float>(iy0));
+	int ix1 = (ix0 + 1) & 0xff;
+	int iy1 = (iy0 + 1) & 0xff;
+	ix0 &= 0xff;
+	iy0 &= 0xff;
+
+	float n0 = Lerp(t, m_values[m_perm[ix0 + m_perm[iy0]]], m_values[m_perm[ix0 + m_perm[iy1]]]);
+	float n1 = Lerp(t, m_values[m_perm[ix1 + m_perm[iy0]]], m_values[m_perm[ix1 + m_perm[iy1]]]);
+
+	return Lerp(s, n0, n1);
+}
+
+float Noise::Value3D(float x, float y, float z)
+{
+	int ix0 = FastFloor(x);
+	int iy0 = FastFloor(y);
+	int iz0 = FastFloor(z);
+	float s = Fade(x - static_cast<float>(ix0));
+	float t = Fade(y - static_cast<float>(iy0));
+	float r = Fade(z - static_cast<float>(iz0));
+	int ix[2] = { ix0 & 0xff, (ix0 + 1) & 0xff };
+	int iy[2] = { iy0 & 0xff, (iy0 + 1) & 0xff };
+	int iz[2] = { iz0 & 0xff, (iz0 + 1) & 0xff };
+	float nx[2];
+
+	for (int a = 0; a < 2; ++a)
+	{
+		float ny[2];
+
+		for (int b = 0; b < 2; ++b)
+		{
+			float nz0 = m_values[m_perm[ix[a] + m_perm[iy[b] + m_perm[iz[0]]]]];
+			float nz1 = m_values[m_perm[ix[a] + m_perm[iy[b] + m_perm[iz[1]]]]];
+			ny[b] = Lerp(r, nz0, nz1);
+		}
+
+		nx[a] = Lerp(t, ny[0], ny[1]);
+	}
+
+	return Lerp(s, nx[0], nx[1]);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Perlin1D
+
+Description:    Returns 1D Perlin gradient noise.
+
+Arguments:      x:		sample position.
+
+Returns:        float:	Noise value, roughly [-1, 1].
+*---------------------------------------------------------------------------*/
+float Noise::Perlin1D(float x)
+{
+	int ix0 = FastFloor(x);
+	float fx0 = x - static_cast<float>(ix0);
+	float fx1 = fx0 - 1.0f;
+	int ix1 = (ix0 + 1) & 0xff;
+	ix0 &= 0xff;
+
+	float s = Fade(fx0);
+	float n0 = Grad1(m_perm[ix0], fx0);
+	float n1 = Grad1(m_perm[ix1], fx1);
+
+	return PERLIN_SCALE_1D * Lerp(s, n0, n1);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Perlin2D
+
+Description:    Returns 2D Perlin gradient noise.
+
+Arguments:      x, y:	sample position.
+
+Returns:        float:	Noise value, roughly [-1, 1].
+*---------------------------------------------------------------------------*/
+float Noise::Perlin2D(float x, float y)
+{
+	int ix0 = FastFloor(x);
+	int iy0 = FastFloor(y);
+	float fx0 = x - static_cast<float>(ix0);
+	float fy0 = y - static_cast<float>(iy0);
+	float fx1 = fx0 - 1.0f;
+	float fy1 = fy0 - 1.0f;
+	int ix1 = (ix0 + 1) & 0xff;
+	int iy1 = (iy0 + 1) & 0xff;
+	ix0 &= 0xff;
+	iy0 &= 0xff;
+
+	float t = Fade(fy0);
+	float s = Fade(fx0);
+
+	float nx0 = Grad2(m_perm[ix0 + m_perm[iy0]], fx0, fy0);
+	float nx1 = Grad2(m_perm[ix0 + m_perm[iy1]], fx0, fy1);
+	float n0 = Lerp(t, nx0, nx1);
+
+	nx0 = Grad2(m_perm[ix1 + m_perm[iy0]], fx1, fy0);
+	nx1 = Grad2(m_perm[ix1 + m_perm[iy1]], fx1, fy1);
+	float n1 = Lerp(t, nx0, nx1);
+
+	return PERLIN_SCALE_2D * Lerp(s, n0, n1);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Perlin3D
+
+Description:    Returns 3D Perlin gradient noise.
+
+Arguments:      x, y, z:	sample position.
+
+Returns:        float:		Noise value, roughly [-1, 1].
+*---------------------------------------------------------------------------*/
+float Noise::Perlin3D(float x, float y, float z)
+{
+	int ix0 = FastFloor(x);
+	int iy0 = FastFloor(y);
+	int iz0 = FastFloor(z);
+	float fx0 = x - static_cast<float>(ix0);
+	float fy0 = y - static_cast<float>(iy0);
+	float fz0 = z - static_cast<float>(iz0);
+	float fx1 = fx0 - 1.0f;
+	float fy1 = fy0 - 1.0f;
+	float fz1 = fz0 - 1.0f;
+	int ix1 = (ix0 + 1) & 0xff;
+	int iy1 = (iy0 + 1) & 0xff;
+	int iz1 = (iz0 + 1) & 0xff;
+	ix0 &= 0xff;
+	iy0 &= 0xff;
+	iz0 &= 0xff;
+
+	float r = Fade(fz0);
+	float t = Fade(fy0);
+	float s = Fade(fx0);
+
+	float nxy0 = Grad3(m_perm[ix0 + m_perm[iy0 + m_perm[iz0]]], fx0, fy0, fz0);
+	float nxy1 = Grad3(m_perm[ix0 + m_perm[iy0 + m_perm[iz1]]], fx0, fy0, fz1);
+	float nx0 = Lerp(r, nxy0, nxy1);
+
+	nxy0 = Grad3(m_perm[ix0 + m_perm[iy1 + m_perm[iz0]]], fx0, fy1, fz0);
+	nxy1 = Grad3(m_perm[ix0 + m_perm[iy1 + m_perm[iz1]]], fx0, fy1, fz1);
+	float nx1 = Lerp(r, nxy0, nxy1);
+
+	float n0 = Lerp(t, nx0, nx1);
+
+	nxy0 = Grad3(m_perm[ix1 + m_perm[iy0 + m_perm[iz0]]], fx1, fy0, fz0);
+	nxy1 = Grad3(m_perm[ix1 + m_perm[iy0 + m_perm[iz1]]], fx1, fy0, fz1);
+	nx0 = Lerp(r, nxy0, nxy1);
+
+	nxy0 = Grad3(m_perm[ix1 + m_perm[iy1 + m_perm[iz0]]], fx1, fy1, fz0);
+	nxy1 = Grad3(m_perm[ix1 + m_perm[iy1 + m_perm[iz1]]], fx1, fy1, fz1);
+	nx1 = Lerp(r, nxy0, nxy1);
+
+	float n1 = Lerp(t, nx0, nx1);
+
+	return PERLIN_SCALE_3D * Lerp(s, n0, n1);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Perlin4D
+
+Description:    Returns 4D Perlin gradient noise.
+				Corners are blended along w first, then z, y and x.
+
+Arguments:      x, y, z, w:	sample position.
+
+Returns:        float:		Noise value, roughly [-1, 1].
+*---------------------------------------------------------------------------*/
+float Noise::Perlin4D(float x, float y, float z, float w)
+{
+	int ix0 = FastFloor(x);
+	int iy0 = FastFloor(y);
+	int iz0 = FastFloor(z);
+	int iw0 = FastFloor(w);
+	float fx[2] = { x - static_cast<float>(ix0), 0.0f };
+	float fy[2] = { y - static_cast<float>(iy0), 0.0f };
+	float fz[2] = { z - static_cast<float>(iz0), 0.0f };
+	float fw[2] = { w - static_cast<float>(iw0), 0.0f };
+	fx[1] = fx[0] - 1.0f;
+	fy[1] = fy[0] - 1.0f;
+	fz[1] = fz[0] - 1.0f;
+	fw[1] = fw[0] - 1.0f;
+	int ix[2] = { ix0 & 0xff, (ix0 + 1) & 0xff };
+	int iy[2] = { iy0 & 0xff, (iy0 + 1) & 0xff };
+	int iz[2] = { iz0 & 0xff, (iz0 + 1) & 0xff };
+	int iw[2] = { iw0 & 0xff, (iw0 + 1) & 0xff };
+
+	float q = Fade(fw[0]);
+	float r = Fade(fz[0]);
+	float t = Fade(fy[0]);
+	float s = Fade(fx[0]);
+	float nx[2];
+
+	for (int a = 0; a < 2; ++a)
+	{
+		float ny[2];
+
+		for (int b = 0; b < 2; ++b)
+		{
+			float nz[2];
+
+			for (int c = 0; c < 2; ++c)
+			{
+				float nw0 = Grad4(m_perm[ix[a] + m_perm[iy[b] + m_perm[iz[c] + m_perm[iw[0]]]]], fx[a], fy[b], fz[c], fw[0]);
+				float nw1 = Grad4(m_perm[ix[a] + m_perm[iy[b] + m_perm[iz[c] + m_perm[iw[1]]]]], fx[a], fy[b], fz[c], fw[1]);
+				nz[c] = Lerp(q, nw0, nw1);
+			}
+
+			ny[b] = Lerp(r, nz[0], nz[1]);
+		}
+
+		nx[a] = Lerp(t, ny[0], ny[1]);
+	}
+
+	return PERLIN_SCALE_4D * Lerp(s, nx[0], nx[1]);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Simplex1D
+
+Description:    Returns 1D simplex noise. The 1D simplex is the unit interval,
+				so only the falloff differs from Perlin1D: each end adds its
+				gradient ramp weighted by (1 - d^2)^4 instead of being faded
+				into the other.
+
+Arguments:      x:		sample position.
+
+Returns:        float:	Noise value, roughly [-1, 1].
+*---------------------------------------------------------------------------*/
+float Noise::Simplex1D(float x)
+{
+	int i0 = FastFloor(x);
+	float x0 = x - static_cast<float>(i0);
+	float x1 = x0 - 1.0f;
+	int i1 = (i0 + 1) & 0xff;
+	i0 &= 0xff;
+
+	float t0 = 1.0f - x0 * x0;
+	t0 *= t0;
+	float n0 = t0 * t0 * Grad1(m_perm[i0], x0);
+
+	float t1 = 1.0f - x1 * x1;
+	t1 *= t1;
+	float n1 = t1 * t1 * Grad1(m_perm[i1], x1);
+
+	// largest sum is 8 * (3 / 4)^4 at the middle of the interval
+
+	return SIMPLEX_SCALE_1D * (n0 + n1);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Simplex2D
+
+Description:    Returns 2D simplex noise.
+
+Arguments:      x, y:	sample position.
+
+Returns:        float:	Noise value, roughly [-1, 1].
+*---------------------------------------------------------------------------*/
+float Noise::Simplex2D(float x, float y)
+{
+	// skew the input space to find the simplex cell
+
+	float s = (x + y) * SIMPLEX_F2;
+	int i = FastFloor(x + s);
+	int j = FastFloor(y + s);
+
+	float t = static_cast<float>(i + j) * SIMPLEX_G2;
+	float x0 = x - (static_cast<float>(i) - t);
+	float y0 = y - (static_cast<float>(j) - t);
+
+	// lower or upper triangle of the cell
+
+	int i1 = (x0 > y0) ? 1 : 0;
+	int j1 = 1 - i1;
+
+	float x1 = x0 - static_cast<float>(i1) + SIMPLEX_G2;
+	float y1 = y0 - static_cast<float>(j1) + SIMPLEX_G2;
+	float x2 = x0 - 1.0f + 2.0f * SIMPLEX_G2;
+	float y2 = y0 - 1.0f + 2.0f * SIMPLEX_G2;
+
+	int ii = i & 0xff;
+	int jj = j & 0xff;
+	float n = 0.0f;
+
+	float t0 = 0.5f - x0 * x0 - y0 * y0;
+	if (t0 > 0.0f)
+	{
+		t0 *= t0;
+		n += t0 * t0 * Grad2(m_perm[ii + m_perm[jj]], x0, y0);
+	}
+
+	float t1 = 0.5f - x1 * x1 - y1 * y1;
+	if (t1 > 0.0f)
+	{
+		t1 *= t1;
+		n += t1 * t1 * Grad2(m_perm[ii + i1 + m_perm[jj + j1]], x1, y1);
+	}
+
+	float t2 = 0.5f - x2 * x2 - y2 * y2;
+	if (t2 > 0.0f)
+	{
+		t2 *= t2;
+		n += t2 * t2 * Grad2(m_perm[ii + 1 + m_perm[jj + 1]], x2, y2);
+	}
+
+	return SIMPLEX_SCALE_2D * n;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Simplex3D
+
+Description:    Returns 3D simplex noise.
+
+Arguments:      x, y, z:	sample position.
+
+Returns:        float:		Noise value, roughly [-1, 1].
+*---------------------------------------------------------------------------*/
+float Noise::Simplex3D(float x, float y, float z)
+{
+	// skew the input space to find the simplex cell
+
+	float s = (x + y + z) * SIMPLEX_F3;
+	int i = FastFloor(x + s);
+	int j = FastFloor(y + s);
+	int k = FastFloor(z + s);
+
+	float t = static_cast<float>(i + j + k) * SIMPLEX_G3;
+	float x0 = x - (static_cast<float>(i) - t);
+	float y0 = y - (static_cast<float>(j) - t);
+	float z0 = z - (static_cast<float>(k) - t);
+
+	// offsets of the second and third corner of the simplex
+
+	int i1, j1, k1, i2, j2, k2;
+
+	if (x0 >= y0)
+	{
+		if (y0 >= z0)		{ i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 1; k2 = 0; }
+		else if (x0 >= z0)	{ i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 0; k2 = 1; }
+		else				{ i1 = 0; j1 = 0; k1 = 1; i2 = 1; j2 = 0; k2 = 1; }
+	}
+	else
+	{
+		if (y0 < z0)		{ i1 = 0; j1 = 0; k1 = 1; i2 = 0; j2 = 1; k2 = 1; }
+		else if (x0 < z0)	{ i1 = 0; j1 = 1; k1 = 0; i2 = 0; j2 = 1; k2 = 1; }
+		else				{ i1 = 0; j1 = 1; k1 = 0; i2 = 1; j2 = 1; k2 = 0; }
+	}
+
+	float x1 = x0 - static_cast<float>(i1) + SIMPLEX_G3;
+	float y1 = y0 - static_cast<float>(j1) + SIMPLEX_G3;
+	float z1 = z0 - static_cast<float>(k1) + SIMPLEX_G3;
+	float x2 = x0 - static_cast<float>(i2) + 2.0f * SIMPLEX_G3;
+	float y2 = y0 - static_cast<float>(j2) + 2.0f * SIMPLEX_G3;
+	float z2 = z0 - static_cast<float>(k2) + 2.0f * SIMPLEX_G3;
+	float x3 = x0 - 1.0f + 3.0f * SIMPLEX_G3;
+	float y3 = y0 - 1.0f + 3.0f * SIMPLEX_G3;
+	float z3 = z0 - 1.0f + 3.0f * SIMPLEX_G3;
+
+	int ii = i & 0xff;
+	int jj = j & 0xff;
+	int kk = k & 0xff;
+	float n = 0.0f;
+
+	float t0 = 0.6f - x0 * x0 - y0 * y0 - z0 * z0;
+	if (t0 > 0.0f)
+	{
+		t0 *= t0;
+		n += t0 * t0 * Grad3(m_perm[ii + m_perm[jj + m_perm[kk]]], x0, y0, z0);
+	}
+
+	float t1 = 0.6f - x1 * x1 - y1 * y1 - z1 * z1;
+	if (t1 > 0.0f)
+	{
+		t1 *= t1;
+		n += t1 * t1 * Grad3(m_perm[ii + i1 + m_perm[jj + j1 + m_perm[kk + k1]]], x1, y1, z1);
+	}
+
+	float t2 = 0.6f - x2 * x2 - y2 * y2 - z2 * z2;
+	if (t2 > 0.0f)
+	{
+		t2 *= t2;
+		n += t2 * t2 * Grad3(m_perm[ii + i2 + m_perm[jj + j2 + m_perm[kk + k2]]], x2, y2, z2);
+	}
+
+	float t3 = 0.6f - x3 * x3 - y3 * y3 - z3 * z3;
+	if (t3 > 0.0f)
+	{
+		t3 *= t3;
+		n += t3 * t3 * Grad3(m_perm[ii + 1 + m_perm[jj + 1 + m_perm[kk + 1]]], x3, y3, z3);
+	}
+
+	return SIMPLEX_SCALE_3D * n;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Simplex4D
+
+Description:    Returns 4D simplex noise.
+				The simplex corners are ordered by ranking the coordinates.
+
+Arguments:      x, y, z, w:	sample position.
+
+Returns:        float:		Noise value, roughly [-1, 1].
+*---------------------------------------------------------------------------*/
+float Noise::Simplex4D(float x, float y, float z, float w)
+{
+	// skew the input space to find the simplex cell
+
+	float s = (x + y + z + w) * SIMPLEX_F4;
+	int i = FastFloor(x + s);
+	int j = FastFloor(y + s);
+	int k = FastFloor(z + s);
+	int l = FastFloor(w + s);
+
+	float t = static_cast<float>(i + j + k + l) * SIMPLEX_G4;
+	float p0[4] = {
+		x - (static_cast<float>(i) - t),
+		y - (static_cast<float>(j) - t),
+		z - (static_cast<float>(k) - t),
+		w - (static_cast<float>(l) - t)
+	};
+
+	// rank each coordinate, the largest one is stepped first
+
+	int rank[4] = {};
+
+	for (int a = 0; a < 4; ++a)
+	{
+		for (int b = a + 1; b < 4; ++b)
+		{
+			if (p0[a] > p0[b])
+				++rank[a];
+			else
+				++rank[b];
+		}
+	}
+
+	int ii = i & 0xff;
+	int jj = j & 0xff;
+	int kk = k & 0xff;
+	int ll = l & 0xff;
+	float n = 0.0f;
+
+	// corner c is offset by one on every axis ranked above 3 - c
+
+	for (int c = 0; c < 5; ++c)
+	{
+		int o[4];
+		float p[4];
+
+		for (int a = 0; a < 4; ++a)
+		{
+			o[a] = (rank[a] >= 4 - c) ? 1 : 0;
+			p[a] = p0[a] - static_cast<float>(o[a]) + static_cast<float>(c) * SIMPLEX_G4;
+		}
+
+		float tc = 0.6f - p[0] * p[0] - p[1] * p[1] - p[2] * p[2] - p[3] * p[3];
+		if (tc > 0.0f)
+		{
+			tc *= tc;
+			int hash = m_perm[ii + o[0] + m_perm[jj + o[1] + m_perm[kk + o[2] + m_perm[ll + o[3]]]]];
+			n += tc * tc * Grad4(hash, p[0], p[1], p[2], p[3]);
+		}
+	}
+
+	return SIMPLEX_SCALE_4D * n;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Fractal2D
+
+Description:    Returns fractal Brownian motion, octaves of noise summed
+				with increasing frequency and decreasing amplitude.
+
+Arguments:      x, y:		sample position.
+				type:		noise function of each octave.
+				octaves:	number of octaves.
+				lacunarity:	frequency multiplier per octave.
+				gain:		amplitude multiplier per octave.
+
+Returns:        float:		Noise value, roughly [-1, 1].
+*---------------------------------------------------------------------------*/
+float Noise::Fractal2D(float x, float y, NoiseType type, int octaves, float lacunarity, float gain)
+{
+	ASSERT_MSG(octaves > 0, "Fractal noise needs at least one octave");
+
+	float total = 0.0f;
+	float frequency = 1.0f;
+	float amplitude = 1.0f;
+	float amplitude_sum = 0.0f;
+
+	for (int i = 0; i < octaves; ++i)
+	{
+		float fx = x * frequency;
+		float fy = y * frequency;
+		float n;
+
+		switch (type)
+		{
+		case NOISE_VALUE:	n = Value2D(fx, fy);	break;
+		case NOISE_SIMPLEX:	n = Simplex2D(fx, fy);	break;
+		default:			n = Perlin2D(fx, fy);	break;
+		}
+
+		total += amplitude * n;
+		amplitude_sum += amplitude;
+		frequency *= lacunarity;
+		amplitude *= gain;
+	}
+
+	return total / amplitude_sum;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Fractal3D
+
+Description:    Returns 3D fractal Brownian motion.
+
+Arguments:      x, y, z:	sample position.
+				type:		noise function of each octave.
+				octaves:	number of octaves.
+				lacunarity:	frequency multiplier per octave.
+				gain:		amplitude multiplier per octave.
+
+Returns:        float:		Noise value, roughly [-1, 1].
+*---------------------------------------------------------------------------*/
+float Noise::Fractal3D(float x, float y, float z, NoiseType type, int octaves, float lacunarity, float gain)
+{
+	ASSERT_MSG(octaves > 0, "Fractal noise needs at least one octave");
+
+	float total = 0.0f;
+	float frequency = 1.0f;
+	float amplitude = 1.0f;
+	float amplitude_sum = 0.0f;
+
+	for (int i = 0; i < octaves; ++i)
+	{
+		float fx = x * frequency;
+		float fy = y * frequency;
+		float fz = z * frequency;
+		float n;
+
+		switch (type)
+		{
+		case NOISE_VALUE:	n = Value3D(fx, fy, fz);	break;
+		case NOISE_SIMPLEX:	n = Simplex3D(fx, fy, fz);	break;
+		default:			n = Perlin3D(fx, fy, fz);	break;
+		}
+
+		total += amplitude * n;
+		amplitude_sum += amplitude;
+		frequency *= lacunarity;
+		amplitude *= gain;
+	}
+
+	return total / amplitude_sum;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Perlin2DGrid
+
+Description:    Fills width * height samples (row major) of Perlin noise.
+				Sample (col, row) is taken at (x + col * step, y + row * step).
+				Each row is evaluated 4 samples at a time with SSE2.
+
+Arguments:      output:	buffer of at least width * height floats.
+				width:	samples per row.
+				height:	number of rows.
+				x, y:	position of the first sample.
+				step:	distance between samples.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Noise::Perlin2DGrid(float *output, int width, int height, float x, float y, float step)
+{
+	for (int row = 0; row < height; ++row)
+		PerlinRow2D(output + row * width, width, x, y + static_cast<float>(row) * step, step);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Perlin3DGrid
+
+Description:    Fills a width * height tile (row major) of 3D Perlin noise at depth z.
+
+Arguments:      output:		buffer of at least width * height floats.
+				width:		samples per row.
+				height:		number of rows.
+				x, y, z:	position of the first sample.
+				step:		distance between samples.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Noise::Perlin3DGrid(float *output, int width, int height, float x, float y, float z, float step)
+{
+	for (int row = 0; row < height; ++row)
+		PerlinRow3D(output + row * width, width, x, y + static_cast<float>(row) * step, z, step);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Fractal2DGrid
+
+Description:    Fills width * height samples (row major) of fractal Perlin noise.
+				Each octave is evaluated as a vectorized row and accumulated.
+
+Arguments:      output:		buffer of at least width * height floats.
+				width:		samples per row.
+				height:		number of rows.
+				x, y:		position of the first sample.
+				step:		distance between samples.
+				octaves:	number of octaves.
+				lacunarity:	frequency multiplier per octave.
+				gain:		amplitude multiplier per octave.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Noise::Fractal2DGrid(float *output, int width, int height, float x, float y, float step,
+	int octaves, float lacunarity, float gain)
+{
+	ASSERT_MSG(octaves > 0, "Fractal noise needs at least one octave");
+
+	float octave[NOISE_ROW_CHUNK];
+	float amplitude_sum = 0.0f;
+	float amplitude = 1.0f;
+
+	for (int i = 0; i < octaves; ++i)
+	{
+		amplitude_sum += amplitude;
+		amplitude *= gain;
+	}
+
+	float normalize = 1.0f / amplitude_sum;
+
+	for (int row = 0; row < height; ++row)
+	{
+		float row_y = y + static_cast<float>(row) * step;
+
+		for (int col = 0; col < width; col += NOISE_ROW_CHUNK)
+		{
+			int count = (std::min)(NOISE_ROW_CHUNK, width - col);
+			float *out = output + row * width + col;
+			float col_x = x + static_cast<float>(col) * step;
+			float frequency = 1.0f;
+			amplitude = normalize;
+
+			std::fill(out, out + count, 0.0f);
+
+			for (int i = 0; i < octaves; ++i)
+			{
+				PerlinRow2D(octave, count, col_x * frequency, row_y * frequency, step * frequency);
+
+				for (int j = 0; j < count; ++j)
+					out[j] += amplitude * octave[j];
+
+				frequency *= lacunarity;
+				amplitude *= gain;
+			}
+		}
+	}
+}
+
+// private functions
+
+/*--------------------------------------------------------------------------*
+Name:           PerlinRow2D
+
+Description:    One row of 2D Perlin noise. The y lattice is shared by the
+				whole row, only the x lattice changes per sample.
+
+Arguments:      output:	buffer of at least count floats.
+				count:	number of samples.
+				x, y:	position of the first sample.
+				step:	distance between samples.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Noise::PerlinRow2D(float *output, int count, float x, float y, float step)
+{
+	int i = 0;
+
+#ifdef RANDOM_USE_SSE2
+	int iy0 = FastFloor(y);
+	float fy0 = y - static_cast<float>(iy0);
+	int iy1 = (iy0 + 1) & 0xff;
+	iy0 &= 0xff;
+
+	const int py0 = m_perm[iy0];
+	const int py1 = m_perm[iy1];
+	const __m128 v_fy0 = _mm_set1_ps(fy0);
+	const __m128 v_fy1 = _mm_set1_ps(fy0 - 1.0f);
+	const __m128 v_t = _mm_set1_ps(Fade(fy0));
+	const __m128 v_one = _mm_set1_ps(1.0f);
+	const __m128 v_lane = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+	const __m128 v_x = _mm_set1_ps(x);
+	const __m128 v_step = _mm_set1_ps(step);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 px = _mm_add_ps(v_x, _mm_mul_ps(_mm_add_ps(_mm_set1_ps(static_cast<float>(i)), v_lane), v_step));
+		__m128i ix0 = FastFloor4(px);
+		__m128 fx0 = _mm_sub_ps(px, _mm_cvtepi32_ps(ix0));
+		__m128 fx1 = _mm_sub_ps(fx0, v_one);
+
+		// SSE2 has no gather, hash the 4 lanes with scalar table lookups
+
+		int ix[4];
+		int h00[4], h01[4], h10[4], h11[4];
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(ix), ix0);
+
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			int a = ix[lane] & 0xff;
+			int b = (ix[lane] + 1) & 0xff;
+			h00[lane] = m_perm[a + py0];
+			h01[lane] = m_perm[a + py1];
+			h10[lane] = m_perm[b + py0];
+			h11[lane] = m_perm[b + py1];
+		}
+
+		__m128 nx0 = Grad2_4(_mm_loadu_si128(reinterpret_cast<const __m128i *>(h00)), fx0, v_fy0);
+		__m128 nx1 = Grad2_4(_mm_loadu_si128(reinterpret_cast<const __m128i *>(h01)), fx0, v_fy1);
+		__m128 n0 = Lerp4(v_t, nx0, nx1);
+
+		nx0 = Grad2_4(_mm_loadu_si128(reinterpret_cast<const __m128i *>(h10)), fx1, v_fy0);
+		nx1 = Grad2_4(_mm_loadu_si128(reinterpret_cast<const __m128i *>(h11)), fx1, v_fy1);
+		__m128 n1 = Lerp4(v_t, nx0, nx1);
+
+		__m128 n = Lerp4(Fade4(fx0), n0, n1);
+		_mm_storeu_ps(output + i, _mm_mul_ps(_mm_set1_ps(PERLIN_SCALE_2D), n));
+	}
+#endif
+
+	for (; i < count; ++i)
+		output[i] = Perlin2D(x + static_cast<float>(i) * step, y);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           PerlinRow3D
+
+Description:    One row of 3D Perlin noise. The y/z lattice is shared by the
+				whole row, only the x lattice changes per sample.
+
+Arguments:      output:		buffer of at least count floats.
+				count:		number of samples.
+				x, y, z:	position of the first sample.
+				step:		distance between samples.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Noise::PerlinRow3D(float *output, int count, float x, float y, float z, float step)
+{
+	int i = 0;
+
+#ifdef RANDOM_USE_SSE2
+	int iy0 = FastFloor(y);
+	int iz0 = FastFloor(z);
+	float fy0 = y - static_cast<float>(iy0);
+	float fz0 = z - static_cast<float>(iz0);
+	int iy1 = (iy0 + 1) & 0xff;
+	int iz1 = (iz0 + 1) & 0xff;
+	iy0 &= 0xff;
+	iz0 &= 0xff;
+
+	// partial hashes of the 4 (y, z) corners
+	const int p00 = m_perm[iy0 + m_perm[iz0]];
+	const int p01 = m_perm[iy0 + m_perm[iz1]];
+	const int p10 = m_perm[iy1 + m_perm[iz0]];
+	const int p11 = m_perm[iy1 + m_perm[iz1]];
+
+	const __m128 v_fy0 = _mm_set1_ps(fy0);
+	const __m128 v_fy1 = _mm_set1_ps(fy0 - 1.0f);
+	const __m128 v_fz0 = _mm_set1_ps(fz0);
+	const __m128 v_fz1 = _mm_set1_ps(fz0 - 1.0f);
+	const __m128 v_r = _mm_set1_ps(Fade(fz0));
+	const __m128 v_t = _mm_set1_ps(Fade(fy0));
+	const __m128 v_one = _mm_set1_ps(1.0f);
+	const __m128 v_lane = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+	const __m128 v_x = _mm_set1_ps(x);
+	const __m128 v_step = _mm_set1_ps(step);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 px = _mm_add_ps(v_x, _mm_mul_ps(_mm_add_ps(_mm_set1_ps(static_cast<float>(i)), v_lane), v_step));
+		__m128i ix0 = FastFloor4(px);
+		__m128 fx[2];
+		fx[0] = _mm_sub_ps(px, _mm_cvtepi32_ps(ix0));
+		fx[1] = _mm_sub_ps(fx[0], v_one);
+
+		// h[corner x][corner y][corner z][lane]
+
+		int ix[4];
+		int h[2][2][2][4];
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(ix), ix0);
+
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			for (int a = 0; a < 2; ++a)
+			{
+				int c = (ix[lane] + a) & 0xff;
+				h[a][0][0][lane] = m_perm[c + p00];
+				h[a][0][1][lane] = m_perm[c + p01];
+				h[a][1][0][lane] = m_perm[c + p10];
+				h[a][1][1][lane] = m_perm[c + p11];
+			}
+		}
+
+		__m128 n[2];
+
+		for (int a = 0; a < 2; ++a)
+		{
+			__m128 nxy0 = Grad3_4(_mm_loadu_si128(reinterpret_cast<const __m128i *>(h[a][0][0])), fx[a], v_fy0, v_fz0);
+			__m128 nxy1 = Grad3_4(_mm_loadu_si128(reinterpret_cast<const __m128i *>(h[a][0][1])), fx[a], v_fy0, v_fz1);
+			__m128 nx0 = Lerp4(v_r, nxy0, nxy1);
+
+			nxy0 = Grad3_4(_mm_loadu_si128(reinterpret_cast<const __m128i *>(h[a][1][0])), fx[a], v_fy1, v_fz0);
+			nxy1 = Grad3_4(_mm_loadu_si128(reinterpret_cast<const __m128i *>(h[a][1][1])), fx[a], v_fy1, v_fz1);
+			__m128 nx1 = Lerp4(v_r, nxy0, nxy1);
+
+			n[a] = Lerp4(v_t, nx0, nx1);
+		}
+
+		__m128 value = Lerp4(Fade4(fx[0]), n[0], n[1]);
+		_mm_storeu_ps(output + i, _mm_mul_ps(_mm_set1_ps(PERLIN_SCALE_3D), value));
+	}
+#endif
+
+	for (; i < count; ++i)
+		output[i] = Perlin3D(x + static_cast<float>(i) * step, y, z);
+}
\ No newline at end of file
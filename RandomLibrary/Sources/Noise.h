@@ -0,0 +1,108 @@
+/******************************************************************************/
+/*!
+\file		Noise.h
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Coherent noise (value, Perlin, simplex) seeded from Random.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+#include "Random.h"
+
+// static variables
+
+static const int NOISE_TABLE_SIZE = 256;
+static const int DEFAULT_NOISE_OCTAVES = 4;
+static const float DEFAULT_NOISE_LACUNARITY = 2.0f;
+static const float DEFAULT_NOISE_GAIN = 0.5f;
+
+// noise function used by fractal (fBm) sums
+enum NoiseType
+{
+	NOISE_VALUE,
+	NOISE_PERLIN,
+	NOISE_SIMPLEX
+};
+
+class Noise
+{
+public:
+
+	/* constructor/destructor */
+
+	// constructor (tables are built from the random stream)
+	Noise(Random &random);
+
+	// destructor
+	~Noise();
+
+	/* methods */
+
+	// rebuild permutation and value tables from the random stream
+	void Reseed(Random &random);
+
+	// Returns value noise in range of [-1, 1]
+	float Value1D(float x);
+	float Value2D(float x, float y);
+	float Value3D(float x, float y, float z);
+
+	// Returns Perlin gradient noise, roughly in range of [-1, 1]
+	float Perlin1D(float x);
+	float Perlin2D(float x, float y);
+	float Perlin3D(float x, float y, float z);
+	float Perlin4D(float x, float y, float z, float w);
+
+	// Returns simplex noise, roughly in range of [-1, 1]
+	float Simplex1D(float x);
+	float Simplex2D(float x, float y);
+	float Simplex3D(float x, float y, float z);
+	float Simplex4D(float x, float y, float z, float w);
+
+	// Returns fractal Brownian motion (sum of octaves) normalized to roughly [-1, 1]
+	float Fractal2D(float x, float y,
+		NoiseType type = NOISE_PERLIN,
+		int octaves = DEFAULT_NOISE_OCTAVES,
+		float lacunarity = DEFAULT_NOISE_LACUNARITY,
+		float gain = DEFAULT_NOISE_GAIN);
+
+	float Fractal3D(float x, float y, float z,
+		NoiseType type = NOISE_PERLIN,
+		int octaves = DEFAULT_NOISE_OCTAVES,
+		float lacunarity = DEFAULT_NOISE_LACUNARITY,
+		float gain = DEFAULT_NOISE_GAIN);
+
+	// Fills width * height samples (row major) of Perlin noise
+	// sample (col, row) is taken at (x + col * step, y + row * step)
+	void Perlin2DGrid(float *output, int width, int height, float x, float y, float step);
+
+	// Fills a width * height tile of 3D Perlin noise at depth z
+	void Perlin3DGrid(float *output, int width, int height, float x, float y, float z, float step);
+
+	// Fills width * height samples of fractal Perlin noise
+	void Fractal2DGrid(float *output, int width, int height, float x, float y, float step,
+		int octaves = DEFAULT_NOISE_OCTAVES,
+		float lacunarity = DEFAULT_NOISE_LACUNARITY,
+		float gain = DEFAULT_NOISE_GAIN);
+
+private:
+
+	/* helper functions */
+
+	// one row of Perlin noise, 4 samples at a time when SSE2 is available
+	void PerlinRow2D(float *output, int count, float x, float y, float step);
+	void PerlinRow3D(float *output, int count, float x, float y, float z, float step);
+
+	/* variables */
+
+	// permutation table (repeated twice to avoid index wrapping)
+	unsigned char m_perm[NOISE_TABLE_SIZE * 2];
+
+	// lattice values for value noise
+	float m_values[NOISE_TABLE_SIZE];
+};
\ No newline at end of file
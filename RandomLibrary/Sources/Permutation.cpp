@@ -0,0 +1,255 @@
+/******************************************************************************/
+/*!
+\file		Permutation.cpp
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Keyed pseudo-random permutation of [0, size) that is never materialized.
+			Cycle-walking Feistel network keyed from Random.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "Permutation.h"
+#include "MyAssert.h"
+
+// helper functions
+
+/*--------------------------------------------------------------------------*
+Name:           Mix
+
+Description:    64-bit finalizer (splitmix64), every input bit affects every output bit.
+
+Arguments:      value:					value to mix.
+
+Returns:        unsigned long long:		Mixed value.
+*---------------------------------------------------------------------------*/
+static inline unsigned long long Mix(unsigned long long value)
+{
+	value ^= value >> 30;
+	value *= 0xBF58476D1CE4E5B9ull;
+	value ^= value >> 27;
+	value *= 0x94D049BB133111EBull;
+	value ^= value >> 31;
+
+	return value;
+}
+
+// public functions
+
+/*--------------------------------------------------------------------------*
+Name:           Permutation
+
+Description:    Constructor, draws the round keys from random.
+
+Arguments:      random:		random number generator to key from.
+				size:		number of elements (at least 1).
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+Permutation::Permutation(Random &random, unsigned long long size) : m_size(size)
+{
+	ASSERT_MSG(size > 0, "Permutation needs at least one element");
+
+	// bits needed for size - 1, rounded up to an even count (at least 2)
+
+	int bits = 0;
+
+	while ((bits < 64) && (((size - 1) >> bits) != 0))
+		++bits;
+
+	m_half_bits = (bits + 1) / 2;
+
+	if (m_half_bits == 0)
+		m_half_bits = 1;
+
+	m_half_mask = (1ull << m_half_bits) - 1;
+
+	for (int i = 0; i < PERMUTATION_ROUNDS; ++i)
+	{
+		unsigned long long high = random.RawBits();
+		unsigned long long low = random.RawBits();
+
+		m_keys[i] = (high << 32) | low;
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           ~Permutation
+
+Description:    Destructor.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+Permutation::~Permutation()
+{
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Map
+
+Description:    Element at a position.
+
+Arguments:      position:				position [0, size).
+
+Returns:        unsigned long long:		Element [0, size).
+*---------------------------------------------------------------------------*/
+unsigned long long Permutation::Map(unsigned long long position) const
+{
+	ASSERT_MSG(position < m_size, "Permutation position is out of range");
+
+	// the network permutes the whole bit domain, so walking the cycle
+	// from a value inside [0, size) always comes back inside
+
+	unsigned long long value = Encrypt(position);
+
+	while (value >= m_size)
+		value = Encrypt(value);
+
+	return value;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Unmap
+
+Description:    Position of an element (inverse of Map).
+
+Arguments:      element:				element [0, size).
+
+Returns:        unsigned long long:		Position [0, size).
+*---------------------------------------------------------------------------*/
+unsigned long long Permutation::Unmap(unsigned long long element) const
+{
+	ASSERT_MSG(element < m_size, "Permutation element is out of range");
+
+	unsigned long long value = Decrypt(element);
+
+	while (value >= m_size)
+		value = Decrypt(value);
+
+	return value;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Map
+
+Description:    Elements of consecutive positions.
+
+Arguments:      first:		first position.
+				output:		buffer of at least count elements.
+				count:		number of positions (first + count <= size).
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Permutation::Map(unsigned long long first, unsigned long long *output, int count) const
+{
+	ASSERT_MSG(first + count <= m_size, "Permutation positions are out of range");
+
+	for (int i = 0; i < count; ++i)
+	{
+		unsigned long long value = Encrypt(first + i);
+
+		while (value >= m_size)
+			value = Encrypt(value);
+
+		output[i] = value;
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Split
+
+Description:    Positions of one part when the permutation is split in parts
+				of (almost) equal size, e.g. one per thread.
+
+Arguments:      part:		part index [0, parts).
+				parts:		number of parts.
+				begin:		first position of the part.
+				end:		one past the last position of the part.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Permutation::Split(int part, int parts, unsigned long long &begin, unsigned long long &end) const
+{
+	ASSERT_MSG((parts > 0) && (part >= 0) && (part < parts), "Permutation part is out of range");
+
+	// the first size % parts parts get one extra position
+
+	unsigned long long chunk = m_size / parts;
+	unsigned long long extra = m_size % parts;
+	unsigned long long index = static_cast<unsigned long long>(part);
+
+	begin = index * chunk + ((index < extra) ? index : extra);
+	end = begin + chunk + ((index < extra) ? 1 : 0);
+}
+
+// private functions
+
+/*--------------------------------------------------------------------------*
+Name:           Encrypt
+
+Description:    Forward pass of the network, (L, R) -> (R, L ^ F(R)) per round.
+
+Arguments:      value:					value of 2 * half_bits bits.
+
+Returns:        unsigned long long:		Permuted value.
+*---------------------------------------------------------------------------*/
+unsigned long long Permutation::Encrypt(unsigned long long value) const
+{
+	unsigned long long left = value >> m_half_bits;
+	unsigned long long right = value & m_half_mask;
+
+	for (int i = 0; i < PERMUTATION_ROUNDS; ++i)
+	{
+		unsigned long long next = left ^ Round(right, i);
+
+		left = right;
+		right = next;
+	}
+
+	return (left << m_half_bits) | right;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Decrypt
+
+Description:    Backward pass of the network, undoes Encrypt.
+
+Arguments:      value:					value of 2 * half_bits bits.
+
+Returns:        unsigned long long:		Original value.
+*---------------------------------------------------------------------------*/
+unsigned long long Permutation::Decrypt(unsigned long long value) const
+{
+	unsigned long long left = value >> m_half_bits;
+	unsigned long long right = value & m_half_mask;
+
+	for (int i = PERMUTATION_ROUNDS - 1; i >= 0; --i)
+	{
+		unsigned long long previous = right ^ Round(left, i);
+
+		right = left;
+		left = previous;
+	}
+
+	return (left << m_half_bits) | right;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Round
+
+Description:    Keyed round function.
+
+Arguments:      half:					half of the value.
+				round:					round index.
+
+Returns:        unsigned long long:		half_bits pseudo-random bits.
+*---------------------------------------------------------------------------*/
+unsigned long long Permutation::Round(unsigned long long half, int round) const
+{
+	return Mix(half ^ m_keys[round]) & m_half_mask;
+}
@@ -0,0 +1,85 @@
+/******************************************************************************/
+/*!
+\file		Permutation.h
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Keyed pseudo-random permutation of [0, size) that is never materialized.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+#include "Random.h"
+
+// static variables
+
+// Feistel rounds per step (4 leave a visible bias on small ranges)
+static const int PERMUTATION_ROUNDS = 8;
+
+/*
+	Position i maps to element Map(i) with a balanced Feistel network over the
+	smallest even number of bits that holds size - 1. Results outside
+	[0, size) are fed back through the network (cycle walking) until they
+	land inside, on average less than 4 steps.
+
+	Every call is O(1) time and memory and const, so one permutation can be
+	shared by threads that each walk their own Split range.
+*/
+class Permutation
+{
+public:
+
+	/* constructor/destructor */
+
+	// constructor, round keys are drawn from random
+	Permutation(Random &random, unsigned long long size);
+
+	// destructor
+	~Permutation();
+
+	/* getter/setter */
+
+	unsigned long long GetSize(void) const					{ return m_size; }
+
+	/* methods */
+
+	// element at position [0, size)
+	unsigned long long Map(unsigned long long position) const;
+	unsigned long long operator[](unsigned long long position) const	{ return Map(position); }
+
+	// position of element [0, size) (inverse of Map)
+	unsigned long long Unmap(unsigned long long element) const;
+
+	// elements at positions first ~ first + count - 1
+	void Map(unsigned long long first, unsigned long long *output, int count) const;
+
+	// contiguous positions begin[inclusive] ~ end[exclusive] of part [0, parts) when split in parts
+	void Split(int part, int parts, unsigned long long &begin, unsigned long long &end) const;
+
+private:
+
+	/* helper functions */
+
+	// one pass of the network over the whole bit domain
+	unsigned long long Encrypt(unsigned long long value) const;
+	unsigned long long Decrypt(unsigned long long value) const;
+
+	// round function, half_bits wide
+	unsigned long long Round(unsigned long long half, int round) const;
+
+	/* variables */
+
+	// number of elements
+	unsigned long long m_size;
+
+	// bits of each Feistel half
+	int m_half_bits;
+	unsigned long long m_half_mask;
+
+	// round keys
+	unsigned long long m_keys[PERMUTATION_ROUNDS];
+};
@@ -11,11 +11,176 @@ written consent of DigiPen Institute of Technology is prohibited.
 */
 /******************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <ctime>
 
 #include "Random.h"
+#include "SIMD.h"
 #include "MyAssert.h"
 
+// static variables
+
+// values drawn per transform of the batch APIs
+static const int RANDOM_BATCH_BLOCK = 256;
+
+#ifdef RANDOM_INSTRUMENTATION
+// g_random call sites of this thread (open addressing on file pointer and line)
+static RANDOM_THREAD_LOCAL RandomCallSite s_call_sites[RANDOM_CALL_SITES];
+#endif
+
+// helper functions
+
+/*--------------------------------------------------------------------------*
+Name:           LeadingZeros
+
+Description:    Number of zero bits above the highest set bit.
+
+Arguments:      bits:		value (not 0 in the low width bits).
+				width:		number of low bits that count.
+
+Returns:        int:		Leading zeros [0, width).
+*---------------------------------------------------------------------------*/
+static inline int LeadingZeros(unsigned int bits, int width)
+{
+	int count = 0;
+
+	for (unsigned int bit = 1u << (width - 1); !(bits & bit); bit >>= 1)
+		++count;
+
+	return count;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           UniformTransform
+
+Description:    values[i] = values[i] * (max[i] - min[i]) + min[i], in the same
+				order of operations as uniform_real_distribution.
+
+Arguments:      values:		uniform numbers [0, 1), transformed in place.
+				min:		lower boundries.
+				max:		upper boundries.
+				count:		number of values.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+static void UniformTransform(float *values, const float *min, const float *max, int count)
+{
+	int i = 0;
+
+#ifdef RANDOM_USE_SSE2
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 low = _mm_loadu_ps(min + i);
+		__m128 range = _mm_sub_ps(_mm_loadu_ps(max + i), low);
+
+		_mm_storeu_ps(values + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(values + i), range), low));
+	}
+#endif
+
+	for (; i < count; ++i)
+		values[i] = values[i] * (max[i] - min[i]) + min[i];
+}
+
+/*--------------------------------------------------------------------------*
+Name:           NormalTransform
+
+Description:    values[i] = values[i] * stddev[i] + mean[i], clamped to
+				mean[i] -/+ 3 * stddev[i] if is_clamp (only rounding can reach past it).
+
+Arguments:      values:		standard normal numbers, transformed in place.
+				mean:		mean values.
+				stddev:		standard deviations.
+				count:		number of values.
+				is_clamp:	clamp to 3 standard deviations.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+static void NormalTransform(float *values, const float *mean, const float *stddev, int count, bool is_clamp)
+{
+	int i = 0;
+
+#ifdef RANDOM_USE_SSE2
+	const __m128 three = _mm_set1_ps(3.0f);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 center = _mm_loadu_ps(mean + i);
+		__m128 deviation = _mm_loadu_ps(stddev + i);
+		__m128 value = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(values + i), deviation), center);
+
+		if (is_clamp)
+		{
+			__m128 boundary = _mm_mul_ps(deviation, three);
+
+			value = _mm_max_ps(value, _mm_sub_ps(center, boundary));
+			value = _mm_min_ps(value, _mm_add_ps(center, boundary));
+		}
+
+		_mm_storeu_ps(values + i, value);
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		float value = values[i] * stddev[i] + mean[i];
+
+		if (is_clamp)
+		{
+			float boundary = stddev[i] * 3.0f;
+
+			value = (std::max)(value, mean[i] - boundary);
+			value = (std::min)(value, mean[i] + boundary);
+		}
+
+		values[i] = value;
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           MinMaxTransform
+
+Description:    Normal transform of NormalRangeMinMax: mean = (min + max) / 2,
+				stddev = (mean - min) / 3, clamped to min~max.
+
+Arguments:      values:		standard normal numbers in [-3, 3], transformed in place.
+				min:		lower boundries.
+				max:		upper boundries.
+				count:		number of values.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+static void MinMaxTransform(float *values, const float *min, const float *max, int count)
+{
+	int i = 0;
+
+#ifdef RANDOM_USE_SSE2
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 three = _mm_set1_ps(3.0f);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 low = _mm_loadu_ps(min + i);
+		__m128 high = _mm_loadu_ps(max + i);
+		__m128 center = _mm_mul_ps(_mm_add_ps(low, high), half);
+		__m128 deviation = _mm_div_ps(_mm_sub_ps(center, low), three);
+		__m128 value = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(values + i), deviation), center);
+
+		_mm_storeu_ps(values + i, _mm_min_ps(_mm_max_ps(value, low), high));
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		float center = (min[i] + max[i]) / 2.0f;
+		float deviation = (center - min[i]) / 3.0f;
+		float value = values[i] * deviation + center;
+
+		values[i] = (std::min)((std::max)(value, min[i]), max[i]);
+	}
+}
+
 // public functions
 
 /*--------------------------------------------------------------------------*
@@ -27,7 +192,7 @@ Arguments:      None.
 
 Returns:        None.
 *---------------------------------------------------------------------------*/
-Random::Random() : m_seed(RandomSeed())
+Random::Random() : m_seed(RandomSeed()), m_log(NULL)
 {
 	UseDefaultSeed();
 }
@@ -41,7 +206,7 @@ Arguments:      seed: default seed for random number engine.
 
 Returns:        None.
 *---------------------------------------------------------------------------*/
-Random::Random(unsigned int seed) : m_seed(seed)
+Random::Random(unsigned int seed) : m_seed(seed), m_log(NULL)
 {
 	UseDefaultSeed();
 }
@@ -85,7 +250,9 @@ Returns:        None.
 *---------------------------------------------------------------------------*/
 void Random::UseRandomSeed(void)
 {
+	RANDOM_STAT_RESEED();
 	m_generator.seed(RandomSeed());
+	m_unit_next = RANDOM_UNIT_WORDS;
 }
 
 /*--------------------------------------------------------------------------*
@@ -99,7 +266,9 @@ Returns:        None.
 *---------------------------------------------------------------------------*/
 void Random::UseDefaultSeed(void)
 {
+	RANDOM_STAT_RESEED();
 	m_generator.seed(m_seed);
+	m_unit_next = RANDOM_UNIT_WORDS;
 }
 
 /*--------------------------------------------------------------------------*
@@ -128,9 +297,21 @@ Returns:        int:	Random int number between min~max.
 *---------------------------------------------------------------------------*/
 int Random::RangeInt(int min, int max)
 {
+	RANDOM_STAT_DRAW(RANDOM_API_RANGE_INT);
+
+	DrawValue result;
+
+	if (m_log && ReplayDraw(RANDOM_API_RANGE_INT, result))
+		return result.i;
+
 	std::uniform_int_distribution<int> distribution(min, max);
 
-	return distribution(m_generator);
+	result.i = distribution(m_generator);
+
+	if (m_log)
+		RecordDraw(RANDOM_API_RANGE_INT, result, DrawInt(min), DrawInt(max));
+
+	return result.i;
 }
 
 /*--------------------------------------------------------------------------*
@@ -145,9 +326,21 @@ Returns:        float:	Random float number between min~max.
 *---------------------------------------------------------------------------*/
 float Random::RangeFloat(float min, float max)
 {
+	RANDOM_STAT_DRAW(RANDOM_API_RANGE_FLOAT);
+
+	DrawValue result;
+
+	if (m_log && ReplayDraw(RANDOM_API_RANGE_FLOAT, result))
+		return result.f;
+
 	std::uniform_real_distribution<float> distribution(min, max);
 
-	return distribution(m_generator);
+	result.f = distribution(m_generator);
+
+	if (m_log)
+		RecordDraw(RANDOM_API_RANGE_FLOAT, result, DrawFloat(min), DrawFloat(max));
+
+	return result.f;
 }
 
 /*--------------------------------------------------------------------------*
@@ -169,37 +362,23 @@ Returns:        float:				Random normal (Gaussian) float number (between min~max
 *---------------------------------------------------------------------------*/
 float Random::NormalRange(float mean, float stddev, bool is_clamp, bool calculate_minmax, float min, float max)
 {
-	std::normal_distribution<float> distribution(mean, stddev);
-
-	float value = distribution(m_generator);
-
-	// 0.3% of values will be outside of 3 times standard deviation
-	// use the flag to eliminate such value
-	// if the random value is outside the boundry, reroll another one
+	RANDOM_STAT_DRAW(RANDOM_API_NORMAL_RANGE);
 
-	if (is_clamp)
-	{
-		// use counter to make sure it's not an infinite loop
-		// if it runs for more than 10 times, stop it
+	DrawValue result;
 
-		unsigned int counter = 0;
+	if (m_log && ReplayDraw(RANDOM_API_NORMAL_RANGE, result))
+		return result.f;
 
-		if (calculate_minmax)
-		{
-			min = NormalMin(mean, stddev);
-			max = NormalMax(mean, stddev);
-		}
+	result.f = DrawNormal(mean, stddev, is_clamp, calculate_minmax, min, max);
 
-		while ((value < min) || (value > max))
-		{
-			value = distribution(m_generator);
-			++counter;
+	if (m_log)
+	{
+		unsigned char flags = static_cast<unsigned char>((is_clamp ? DRAWLOG_FLAG_CLAMP : 0) | (calculate_minmax ? DRAWLOG_FLAG_MINMAX : 0));
 
-			ASSERT_MSG(counter < 10 ,"Can't produce normal distribution random number");
-		}
+		RecordDraw(RANDOM_API_NORMAL_RANGE, result, DrawFloat(mean), DrawFloat(stddev), DrawFloat(min), DrawFloat(max), flags);
 	}
 
-	return value;
+	return result.f;
 }
 
 /*--------------------------------------------------------------------------*
@@ -217,13 +396,25 @@ Returns:        float:	Random normal (Gaussian) float number between min~max.
 *---------------------------------------------------------------------------*/
 float Random::NormalRangeMinMax(float min, float max)
 {
+	RANDOM_STAT_DRAW(RANDOM_API_NORMAL_RANGE_MINMAX);
+
+	DrawValue result;
+
+	if (m_log && ReplayDraw(RANDOM_API_NORMAL_RANGE_MINMAX, result))
+		return result.f;
+
 	// calculate mean and standard deviation from min, max
 	// then use such data to get Gaussian random number clamped between min~max
 
 	float mean = (min + max) / 2.0f;
 	float stddev = (mean - min) / 3.0f;
 
-	return NormalRange(mean, stddev, true, false, min, max);
+	result.f = DrawNormal(mean, stddev, true, false, min, max);
+
+	if (m_log)
+		RecordDraw(RANDOM_API_NORMAL_RANGE_MINMAX, result, DrawFloat(min), DrawFloat(max));
+
+	return result.f;
 }
 
 /*--------------------------------------------------------------------------*
@@ -284,9 +475,1193 @@ Returns:        bool:		True or false.
 *---------------------------------------------------------------------------*/
 bool Random::CoinToss(float percentage)
 {
+	RANDOM_STAT_DRAW(RANDOM_API_COIN_TOSS);
 	ASSERT_MSG((percentage <= 1.0f) && (percentage >= 0.0f), "Percentage should be [0-1]");
 
+	DrawValue result;
+
+	if (m_log && ReplayDraw(RANDOM_API_COIN_TOSS, result))
+		return (result.u != 0);
+
 	std::bernoulli_distribution distribution(percentage);
 
-	return distribution(m_generator);
-}
\ No newline at end of file
+	result.u = distribution(m_generator) ? 1 : 0;
+
+	if (m_log)
+		RecordDraw(RANDOM_API_COIN_TOSS, result, DrawFloat(percentage));
+
+	return (result.u != 0);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           RawBits
+
+Description:    Returns 32 uniformly distributed random bits.
+				Takes one engine output when the engine produces 32 bits
+				(mt19937 on MSVC), more otherwise.
+
+Arguments:      None.
+
+Returns:        unsigned int:	Random bits.
+*---------------------------------------------------------------------------*/
+unsigned int Random::RawBits(void)
+{
+	RANDOM_STAT_DRAW(RANDOM_API_RAW_BITS);
+
+	DrawValue result;
+
+	if (m_log && ReplayDraw(RANDOM_API_RAW_BITS, result))
+		return result.u;
+
+	result.u = DrawBits();
+
+	if (m_log)
+		RecordDraw(RANDOM_API_RAW_BITS, result, DrawValue());
+
+	return result.u;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           FillRawBits
+
+Description:    Fills output with count words of 32 random bits.
+				Produces the same sequence as calling RawBits count times.
+
+Arguments:      output:	buffer of at least count words.
+				count:	number of words.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Random::FillRawBits(unsigned int *output, int count)
+{
+	// every word has to go through the log one at a time
+
+	if (m_log)
+	{
+		for (int i = 0; i < count; ++i)
+			output[i] = RawBits();
+
+		return;
+	}
+
+	RANDOM_STAT_DRAWS(RANDOM_API_RAW_BITS, count);
+
+	for (int i = 0; i < count; ++i)
+		output[i] = DrawBits();
+}
+
+/*--------------------------------------------------------------------------*
+Name:           UnitFloat
+
+Description:    Uniform random float number built from words of the unit block.
+				Fixed precision is 24 random bits (one word), full precision
+				draws the exponent from the leading zeros of more bits, so
+				numbers below 2^-24 can come out too.
+
+Arguments:      interval:			ends that can come out.
+				is_full_precision:	every float of the interval can come out.
+
+Returns:        float:				Random number in interval.
+*---------------------------------------------------------------------------*/
+float Random::UnitFloat(RandomInterval interval, bool is_full_precision)
+{
+	RANDOM_STAT_DRAW(RANDOM_API_UNIT_FLOAT);
+
+	return DrawUnitFloat(interval, is_full_precision);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           UnitDouble
+
+Description:    Uniform random double number built from two words of the
+				unit block (53 random bits, or the exponent drawn too in full
+				precision).
+
+Arguments:      interval:			ends that can come out.
+				is_full_precision:	every double of the interval can come out.
+
+Returns:        double:				Random number in interval.
+*---------------------------------------------------------------------------*/
+double Random::UnitDouble(RandomInterval interval, bool is_full_precision)
+{
+	RANDOM_STAT_DRAW(RANDOM_API_UNIT_DOUBLE);
+
+	return DrawUnitDouble(interval, is_full_precision);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           UnitHalf
+
+Description:    Uniform random half number built from one word of the unit
+				block (11 random bits, or the exponent drawn too in full
+				precision).
+
+Arguments:      interval:			ends that can come out.
+				is_full_precision:	every half of the interval can come out.
+
+Returns:        unsigned short:		Half bits of a random number in interval.
+*---------------------------------------------------------------------------*/
+unsigned short Random::UnitHalf(RandomInterval interval, bool is_full_precision)
+{
+	RANDOM_STAT_DRAW(RANDOM_API_UNIT_HALF);
+
+	return DrawUnitHalf(interval, is_full_precision);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           RangeFloat
+
+Description:    Uniform random float number between min and max from one
+				word of the unit block. A result rounded onto an end the
+				interval excludes is moved to the nearest float inside.
+
+Arguments:      min:		lower boundry of range.
+				max:		upper boundry of range.
+				interval:	ends of [min, max] that can come out.
+
+Returns:        float:		Random number in interval.
+*---------------------------------------------------------------------------*/
+float Random::RangeFloat(float min, float max, RandomInterval interval)
+{
+	RANDOM_STAT_DRAW(RANDOM_API_RANGE_FLOAT);
+	ASSERT_MSG(max >= min, "Max should be >= min");
+
+	float result = DrawUnitFloat(interval, false) * (max - min) + min;
+
+	if (max > min)
+	{
+		if ((interval != RANDOM_OPEN_CLOSED) && (result >= max))
+			result = std::nextafter(max, min);
+
+		if ((interval != RANDOM_CLOSED_OPEN) && (result <= min))
+			result = std::nextafter(min, max);
+	}
+
+	return result;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           RangeDouble
+
+Description:    Uniform random double number between min and max from two
+				words of the unit block. A result rounded onto an end the
+				interval excludes is moved to the nearest double inside.
+
+Arguments:      min:		lower boundry of range.
+				max:		upper boundry of range.
+				interval:	ends of [min, max] that can come out.
+
+Returns:        double:		Random number in interval.
+*---------------------------------------------------------------------------*/
+double Random::RangeDouble(double min, double max, RandomInterval interval)
+{
+	RANDOM_STAT_DRAW(RANDOM_API_RANGE_DOUBLE);
+	ASSERT_MSG(max >= min, "Max should be >= min");
+
+	double result = DrawUnitDouble(interval, false) * (max - min) + min;
+
+	if (max > min)
+	{
+		if ((interval != RANDOM_OPEN_CLOSED) && (result >= max))
+			result = std::nextafter(max, min);
+
+		if ((interval != RANDOM_CLOSED_OPEN) && (result <= min))
+			result = std::nextafter(min, max);
+	}
+
+	return result;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           RangeHalf
+
+Description:    Uniform random half number between min and max. Computed in
+				float from one word of the unit block, then rounded to the
+				nearest half; a result on an end the interval excludes is
+				moved to the nearest half inside.
+
+Arguments:      min:				lower boundry of range.
+				max:				upper boundry of range.
+				interval:			ends of [min, max] that can come out.
+
+Returns:        unsigned short:		Half bits of a random number in interval.
+*---------------------------------------------------------------------------*/
+unsigned short Random::RangeHalf(float min, float max, RandomInterval interval)
+{
+	RANDOM_STAT_DRAW(RANDOM_API_RANGE_HALF);
+	ASSERT_MSG(max >= min, "Max should be >= min");
+
+	unsigned short result = FloatToHalf(DrawUnitFloat(interval, false) * (max - min) + min);
+
+	if (max > min)
+	{
+		if ((interval != RANDOM_OPEN_CLOSED) && (HalfToFloat(result) >= max))
+		{
+			result = FloatToHalf(max);
+
+			if (HalfToFloat(result) >= max)
+				result = HalfStep(result, false);
+		}
+
+		if ((interval != RANDOM_CLOSED_OPEN) && (HalfToFloat(result) <= min))
+		{
+			result = FloatToHalf(min);
+
+			if (HalfToFloat(result) <= min)
+				result = HalfStep(result, true);
+		}
+	}
+
+	return result;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           FillInt
+
+Description:    Fills output with count random int numbers between min[inclusive] and max[inclusive].
+				Produces the same sequence as calling RangeInt count times.
+
+Arguments:      output:	buffer of at least count values.
+				count:	number of values.
+				min:	lower boundry of range.
+				max:	upper boundry of range.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Random::FillInt(int *output, int count, int min, int max)
+{
+	// every draw has to go through the log one at a time
+
+	if (m_log)
+	{
+		for (int i = 0; i < count; ++i)
+			output[i] = RangeInt(min, max);
+
+		return;
+	}
+
+	RANDOM_STAT_DRAWS(RANDOM_API_RANGE_INT, count);
+
+	std::uniform_int_distribution<int> distribution(min, max);
+
+	for (int i = 0; i < count; ++i)
+		output[i] = distribution(m_generator);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           FillFloat
+
+Description:    Fills output with count random float numbers between min[inclusive] and max[inclusive].
+				Produces the same sequence as calling RangeFloat count times.
+
+Arguments:      output:	buffer of at least count values.
+				count:	number of values.
+				min:	lower boundry of range.
+				max:	upper boundry of range.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Random::FillFloat(float *output, int count, float min, float max)
+{
+	if (m_log)
+	{
+		for (int i = 0; i < count; ++i)
+			output[i] = RangeFloat(min, max);
+
+		return;
+	}
+
+	RANDOM_STAT_DRAWS(RANDOM_API_RANGE_FLOAT, count);
+
+	std::uniform_real_distribution<float> distribution(min, max);
+
+	for (int i = 0; i < count; ++i)
+		output[i] = distribution(m_generator);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           FillUnitFloat
+
+Description:    Fills output with count uniform random float numbers.
+				Produces the same sequence as calling UnitFloat count times.
+				Fixed precision converts the unit block in SIMD.
+
+Arguments:      output:				buffer of at least count values.
+				count:				number of values.
+				interval:			ends that can come out.
+				is_full_precision:	every float of the interval can come out.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Random::FillUnitFloat(float *output, int count, RandomInterval interval, bool is_full_precision)
+{
+	if (m_log || is_full_precision)
+	{
+		for (int i = 0; i < count; ++i)
+			output[i] = UnitFloat(interval, is_full_precision);
+
+		return;
+	}
+
+	RANDOM_STAT_DRAWS(RANDOM_API_UNIT_FLOAT, count);
+
+	// convert the unused words of the unit block, then refill it
+
+	for (int i = 0; i < count; )
+	{
+		if (m_unit_next == RANDOM_UNIT_WORDS)
+			RefillUnitWords();
+
+		const unsigned int *bits = m_unit_words + m_unit_next;
+		int block = (std::min)(count - i, RANDOM_UNIT_WORDS - m_unit_next);
+		int j = 0;
+
+		m_unit_next += block;
+
+#ifdef RANDOM_USE_SSE2
+		__m128 scale = _mm_set1_ps(1.0f / 16777216.0f);
+		__m128i one = _mm_set1_epi32(1);
+
+		for (; j + 4 <= block; j += 4)
+		{
+			__m128i k = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(bits + j)), 8);
+
+			if (interval == RANDOM_OPEN_CLOSED)
+				k = _mm_add_epi32(k, one);
+			else if (interval == RANDOM_OPEN_OPEN)
+				k = _mm_or_si128(k, one);
+
+			_mm_storeu_ps(output + i + j, _mm_mul_ps(_mm_cvtepi32_ps(k), scale));
+		}
+#endif
+
+		for (; j < block; ++j)
+			output[i + j] = UnitFloatFromBits(bits[j], interval);
+
+		i += block;
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           FillUnitDouble
+
+Description:    Fills output with count uniform random double numbers.
+				Produces the same sequence as calling UnitDouble count times.
+
+Arguments:      output:				buffer of at least count values.
+				count:				number of values.
+				interval:			ends that can come out.
+				is_full_precision:	every double of the interval can come out.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Random::FillUnitDouble(double *output, int count, RandomInterval interval, bool is_full_precision)
+{
+	if (m_log || is_full_precision)
+	{
+		for (int i = 0; i < count; ++i)
+			output[i] = UnitDouble(interval, is_full_precision);
+
+		return;
+	}
+
+	RANDOM_STAT_DRAWS(RANDOM_API_UNIT_DOUBLE, count);
+
+	for (int i = 0; i < count; ++i)
+	{
+		unsigned long long high = NextBits();
+		unsigned long long low = NextBits();
+
+		output[i] = UnitDoubleFromBits((high << 32) | low, interval);
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           FillNormal
+
+Description:    Fills output with count normal distribution random float numbers.
+				Produces the same sequence as calling NormalRange count times.
+
+Arguments:      output:				buffer of at least count values.
+				count:				number of values.
+				mean:				mean value of normal distribution.
+				stddev:				standard deviation.
+				is_clamp:			flag on if the random number is clamped between min~max.
+				calculate_minmax:	should the min/max value be auto-calculated (as 3 times stddev).
+				min:				lower boundry of range.
+				max:				upper boundry of range.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Random::FillNormal(float *output, int count, float mean, float stddev, bool is_clamp, bool calculate_minmax, float min, float max)
+{
+	if (m_log)
+	{
+		for (int i = 0; i < count; ++i)
+			output[i] = NormalRange(mean, stddev, is_clamp, calculate_minmax, min, max);
+
+		return;
+	}
+
+	RANDOM_STAT_DRAWS(RANDOM_API_NORMAL_RANGE, count);
+
+	// NormalRange starts a new distribution per call (dropping its cached second value),
+	// so draw through DrawNormal per value to keep the sequence
+
+	for (int i = 0; i < count; ++i)
+		output[i] = DrawNormal(mean, stddev, is_clamp, calculate_minmax, min, max);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           RangeFloats
+
+Description:    Random float numbers with per-element boundries,
+				output[i] is RangeFloat(min[i], max[i]).
+				Uniform numbers are drawn first, the transform runs in SIMD.
+
+Arguments:      output:	buffer of at least count values.
+				min:	lower boundries.
+				max:	upper boundries.
+				count:	number of values.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Random::RangeFloats(float *output, const float *min, const float *max, int count)
+{
+	// every draw has to go through the log one at a time
+
+	if (m_log)
+	{
+		for (int i = 0; i < count; ++i)
+			output[i] = RangeFloat(min[i], max[i]);
+
+		return;
+	}
+
+	RANDOM_STAT_DRAWS(RANDOM_API_RANGE_FLOAT, count);
+
+	std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+
+	// transform each block while it is still in cache
+
+	for (int i = 0; i < count; i += RANDOM_BATCH_BLOCK)
+	{
+		int block = (std::min)(count - i, RANDOM_BATCH_BLOCK);
+
+		for (int j = 0; j < block; ++j)
+			output[i + j] = distribution(m_generator);
+
+		UniformTransform(output + i, min + i, max + i, block);
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           NormalRanges
+
+Description:    Normal distribution random float numbers with per-element parameters,
+				output[i] is NormalRange(mean[i], stddev[i], is_clamp).
+				Standard normal numbers are drawn (and rerolled) first, the
+				transform runs in SIMD.
+
+Arguments:      output:		buffer of at least count values.
+				mean:		mean values.
+				stddev:		standard deviations.
+				count:		number of values.
+				is_clamp:	flag on if the random numbers are clamped within 3 standard deviations.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Random::NormalRanges(float *output, const float *mean, const float *stddev, int count, bool is_clamp)
+{
+	if (m_log)
+	{
+		for (int i = 0; i < count; ++i)
+			output[i] = NormalRange(mean[i], stddev[i], is_clamp);
+
+		return;
+	}
+
+	RANDOM_STAT_DRAWS(RANDOM_API_NORMAL_RANGE, count);
+
+	for (int i = 0; i < count; i += RANDOM_BATCH_BLOCK)
+	{
+		int block = (std::min)(count - i, RANDOM_BATCH_BLOCK);
+
+		DrawStandardNormals(output + i, block, is_clamp);
+		NormalTransform(output + i, mean + i, stddev + i, block, is_clamp);
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           NormalRangesMinMax
+
+Description:    Normal distribution random float numbers with per-element boundries,
+				output[i] is NormalRangeMinMax(min[i], max[i]).
+
+Arguments:      output:	buffer of at least count values.
+				min:	lower boundries.
+				max:	upper boundries.
+				count:	number of values.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Random::NormalRangesMinMax(float *output, const float *min, const float *max, int count)
+{
+	if (m_log)
+	{
+		for (int i = 0; i < count; ++i)
+			output[i] = NormalRangeMinMax(min[i], max[i]);
+
+		return;
+	}
+
+	RANDOM_STAT_DRAWS(RANDOM_API_NORMAL_RANGE_MINMAX, count);
+
+	for (int i = 0; i < count; i += RANDOM_BATCH_BLOCK)
+	{
+		int block = (std::min)(count - i, RANDOM_BATCH_BLOCK);
+
+		DrawStandardNormals(output + i, block, true);
+		MinMaxTransform(output + i, min + i, max + i, block);
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           GetStats
+
+Description:    Snapshot of counters of this instance.
+				All zero unless RANDOM_INSTRUMENTATION is defined.
+
+Arguments:      None.
+
+Returns:        RandomStats:	Copy of the counters.
+*---------------------------------------------------------------------------*/
+RandomStats Random::GetStats(void) const
+{
+	RandomStats stats;
+	stats.Clear();
+
+#ifdef RANDOM_INSTRUMENTATION
+	m_counters.Snapshot(stats);
+	stats.raw_words = m_generator.GetWords();
+#endif
+
+	return stats;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           ResetStats
+
+Description:    Set counters of this instance to zero.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Random::ResetStats(void)
+{
+#ifdef RANDOM_INSTRUMENTATION
+	m_counters.Reset();
+	m_generator.ResetWords();
+#endif
+}
+
+/*--------------------------------------------------------------------------*
+Name:           GetThreadStats
+
+Description:    Snapshot of counters of the calling thread, summed over every
+				instance used on it. All zero unless RANDOM_INSTRUMENTATION is defined.
+
+Arguments:      None.
+
+Returns:        RandomStats:	Copy of the counters.
+*---------------------------------------------------------------------------*/
+RandomStats Random::GetThreadStats(void)
+{
+#ifdef RANDOM_INSTRUMENTATION
+	return g_random_thread_stats;
+#else
+	RandomStats stats;
+	stats.Clear();
+
+	return stats;
+#endif
+}
+
+/*--------------------------------------------------------------------------*
+Name:           ResetThreadStats
+
+Description:    Set counters and call sites of the calling thread to zero.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Random::ResetThreadStats(void)
+{
+#ifdef RANDOM_INSTRUMENTATION
+	g_random_thread_stats.Clear();
+
+	for (int i = 0; i < RANDOM_CALL_SITES; ++i)
+	{
+		s_call_sites[i].file = NULL;
+		s_call_sites[i].line = 0;
+		s_call_sites[i].count = 0;
+	}
+#endif
+}
+
+/*--------------------------------------------------------------------------*
+Name:           GetThreadCallSites
+
+Description:    Copy g_random call sites of the calling thread, busiest first.
+
+Arguments:      output:		buffer of at least max_count call sites.
+				max_count:	maximum number of call sites to write.
+
+Returns:        int:		Number of call sites written.
+*---------------------------------------------------------------------------*/
+int Random::GetThreadCallSites(RandomCallSite *output, int max_count)
+{
+	int count = 0;
+
+#ifdef RANDOM_INSTRUMENTATION
+	RandomCallSite sites[RANDOM_CALL_SITES];
+
+	for (int i = 0; i < RANDOM_CALL_SITES; ++i)
+	{
+		if (s_call_sites[i].file)
+			sites[count++] = s_call_sites[i];
+	}
+
+	std::sort(sites, sites + count, [](const RandomCallSite &lhs, const RandomCallSite &rhs) { return lhs.count > rhs.count; });
+
+	count = (std::min)(count, max_count);
+	std::copy(sites, sites + count, output);
+#else
+	(void)output;
+	(void)max_count;
+#endif
+
+	return count;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           AtCallSite
+
+Description:    Count one evaluation of g_random at file:line.
+				Evaluations are dropped once the table of the thread is full.
+
+Arguments:      file:	source file (__FILE__).
+				line:	source line (__LINE__).
+
+Returns:        Random&:	This instance.
+*---------------------------------------------------------------------------*/
+Random &Random::AtCallSite(const char *file, int line)
+{
+#ifdef RANDOM_INSTRUMENTATION
+	size_t hash = (reinterpret_cast<size_t>(file) >> 3) ^ (static_cast<size_t>(line) * 2654435761u);
+
+	for (int probe = 0; probe < RANDOM_CALL_SITES; ++probe)
+	{
+		RandomCallSite &site = s_call_sites[(hash + probe) & (RANDOM_CALL_SITES - 1)];
+
+		if ((site.file == file) && (site.line == line))
+		{
+			++site.count;
+			break;
+		}
+
+		if (site.file == NULL)
+		{
+			site.file = file;
+			site.line = line;
+			site.count = 1;
+			break;
+		}
+	}
+#else
+	(void)file;
+	(void)line;
+#endif
+
+	return *this;
+}
+
+// private functions
+
+/*--------------------------------------------------------------------------*
+Name:           DrawNormal
+
+Description:    NormalRange without counting or logging the draw itself
+				(shared by NormalRange and NormalRangeMinMax).
+
+Arguments:      mean:				mean value of normal distribution.
+				stddev:				standard deviation.
+				is_clamp:			flag on if the random number is clamped between min~max.
+				calculate_minmax:	should the min/max value be auto-calculated (as 3 times stddev).
+				min:				lower boundry of range.
+				max:				upper boundry of range.
+
+Returns:        float:				Random normal (Gaussian) float number (between min~max if clamped).
+*---------------------------------------------------------------------------*/
+float Random::DrawNormal(float mean, float stddev, bool is_clamp, bool calculate_minmax, float min, float max)
+{
+	std::normal_distribution<float> distribution(mean, stddev);
+
+	float value = distribution(m_generator);
+
+	// 0.3% of values will be outside of 3 times standard deviation
+	// use the flag to eliminate such value
+	// if the random value is outside the boundry, reroll another one
+
+	if (is_clamp)
+	{
+		// use counter to make sure it's not an infinite loop
+		// if it runs for more than 10 times, stop it
+
+		unsigned int counter = 0;
+
+		if (calculate_minmax)
+		{
+			min = NormalMin(mean, stddev);
+			max = NormalMax(mean, stddev);
+		}
+
+		while ((value < min) || (value > max))
+		{
+			value = distribution(m_generator);
+			++counter;
+
+			ASSERT_MSG(counter < 10 ,"Can't produce normal distribution random number");
+		}
+
+		RANDOM_STAT_REROLL(counter);
+	}
+
+	return value;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           DrawBits
+
+Description:    RawBits without counting or logging the draw.
+				An engine of 32 bits (mt19937 on MSVC) gives them in one
+				call, the same word the distribution would return.
+
+Arguments:      None.
+
+Returns:        unsigned int:	Random bits.
+*---------------------------------------------------------------------------*/
+unsigned int Random::DrawBits(void)
+{
+	if (((Engine::max)() - (Engine::min)()) == 0xFFFFFFFFu)
+		return static_cast<unsigned int>(m_generator() - (Engine::min)());
+
+	std::uniform_int_distribution<unsigned int> distribution(0, 0xFFFFFFFFu);
+
+	return distribution(m_generator);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           NextBits
+
+Description:    32 random bits for the unit numbers, the next word of the
+				unit block. Inline for the unit functions, everything but
+				taking a buffered word is left to DrawUnitWord.
+
+Arguments:      None.
+
+Returns:        unsigned int:	Random bits.
+*---------------------------------------------------------------------------*/
+inline unsigned int Random::NextBits(void)
+{
+	if (m_log || (m_unit_next == RANDOM_UNIT_WORDS))
+		return DrawUnitWord();
+
+	return m_unit_words[m_unit_next++];
+}
+
+/*--------------------------------------------------------------------------*
+Name:           DrawUnitWord
+
+Description:    NextBits when the unit block is used up or a log is attached.
+				With a log attached each word is recorded (or replayed) as
+				a RawBits draw, without counting it as one.
+
+Arguments:      None.
+
+Returns:        unsigned int:	Random bits.
+*---------------------------------------------------------------------------*/
+unsigned int Random::DrawUnitWord(void)
+{
+	DrawValue result;
+
+	if (m_log && ReplayDraw(RANDOM_API_RAW_BITS, result))
+		return result.u;
+
+	if (m_unit_next == RANDOM_UNIT_WORDS)
+		RefillUnitWords();
+
+	result.u = m_unit_words[m_unit_next++];
+
+	if (m_log)
+		RecordDraw(RANDOM_API_RAW_BITS, result, DrawValue());
+
+	return result.u;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           RefillUnitWords
+
+Description:    Draw a new unit block. An engine of 32 bits gives a word per
+				call. A narrower one (minstd_rand0 on libstdc++) gives 24-bit
+				chunks, the low 24 bits of an output below the last whole
+				multiple of 2^24 (1 in 128 is drawn again for minstd_rand0),
+				so no division is needed: 4 chunks make 3 words, the top 24
+				bits of each from its own chunk, the low 8 from the fourth.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Random::RefillUnitWords(void)
+{
+	const unsigned long long range = static_cast<unsigned long long>((Engine::max)() - (Engine::min)()) + 1;
+
+	if (range == 0x100000000ull)
+	{
+		for (int i = 0; i < RANDOM_UNIT_WORDS; ++i)
+			m_unit_words[i] = static_cast<unsigned int>(m_generator() - (Engine::min)());
+	}
+	else
+	{
+		ASSERT_MSG(range >= 0x1000000ull, "Engine should give at least 24 bits");
+
+		const unsigned long long past = range & ~0xFFFFFFull;
+		unsigned int chunks[4];
+
+		for (int i = 0; i < RANDOM_UNIT_WORDS; i += 3)
+		{
+			for (int c = 0; c < 4; ++c)
+			{
+				unsigned long long value;
+
+				do
+				{
+					value = static_cast<unsigned long long>(m_generator() - (Engine::min)());
+				} while (value >= past);
+
+				chunks[c] = static_cast<unsigned int>(value & 0xFFFFFF);
+			}
+
+			m_unit_words[i] = (chunks[0] << 8) | (chunks[3] >> 16);
+			m_unit_words[i + 1] = (chunks[1] << 8) | ((chunks[3] >> 8) & 0xFF);
+			m_unit_words[i + 2] = (chunks[2] << 8) | (chunks[3] & 0xFF);
+		}
+	}
+
+	m_unit_next = 0;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           DrawUnitFloat
+
+Description:    UnitFloat without counting. Full precision takes the low 23
+				bits of a word as mantissa and the exponent from the leading
+				zeros of the rest, the number rounded down to a float. (0, 1]
+				rounds up instead (next float), (0, 1) rerolls a 0.
+
+Arguments:      interval:			ends that can come out.
+				is_full_precision:	every float of the interval can come out.
+
+Returns:        float:				Random number in interval.
+*---------------------------------------------------------------------------*/
+inline float Random::DrawUnitFloat(RandomInterval interval, bool is_full_precision)
+{
+	if (!is_full_precision)
+		return UnitFloatFromBits(NextBits(), interval);
+
+	unsigned int bits;
+
+	do
+	{
+		unsigned int word = NextBits();
+		unsigned int exponent = static_cast<unsigned int>(DrawExponent(word >> 23, 9, 126));
+
+		bits = (exponent << 23) | (word & 0x7FFFFF);
+	} while ((interval == RANDOM_OPEN_OPEN) && (bits == 0));
+
+	if (interval == RANDOM_OPEN_CLOSED)
+		++bits;
+
+	float result;
+	std::memcpy(&result, &bits, sizeof(result));
+
+	return result;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           DrawUnitDouble
+
+Description:    UnitDouble without counting, full precision as DrawUnitFloat
+				with 52 mantissa bits of a 64-bit word.
+
+Arguments:      interval:			ends that can come out.
+				is_full_precision:	every double of the interval can come out.
+
+Returns:        double:				Random number in interval.
+*---------------------------------------------------------------------------*/
+inline double Random::DrawUnitDouble(RandomInterval interval, bool is_full_precision)
+{
+	if (!is_full_precision)
+	{
+		unsigned long long high = NextBits();
+		unsigned long long low = NextBits();
+
+		return UnitDoubleFromBits((high << 32) | low, interval);
+	}
+
+	unsigned long long bits;
+
+	do
+	{
+		unsigned long long high = NextBits();
+		unsigned long long low = NextBits();
+		unsigned long long word = (high << 32) | low;
+		unsigned long long exponent = static_cast<unsigned long long>(DrawExponent(static_cast<unsigned int>(word >> 52), 12, 1022));
+
+		bits = (exponent << 52) | (word & 0xFFFFFFFFFFFFFull);
+	} while ((interval == RANDOM_OPEN_OPEN) && (bits == 0));
+
+	if (interval == RANDOM_OPEN_CLOSED)
+		++bits;
+
+	double result;
+	std::memcpy(&result, &bits, sizeof(result));
+
+	return result;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           DrawUnitHalf
+
+Description:    UnitHalf without counting, full precision as DrawUnitFloat
+				with 10 mantissa bits (the other 22 always hold the exponent).
+
+Arguments:      interval:			ends that can come out.
+				is_full_precision:	every half of the interval can come out.
+
+Returns:        unsigned short:		Half bits of a random number in interval.
+*---------------------------------------------------------------------------*/
+inline unsigned short Random::DrawUnitHalf(RandomInterval interval, bool is_full_precision)
+{
+	if (!is_full_precision)
+		return UnitHalfFromBits(NextBits(), interval);
+
+	unsigned int bits;
+
+	do
+	{
+		unsigned int word = NextBits();
+		unsigned int exponent = static_cast<unsigned int>(DrawExponent(word >> 10, 22, 14));
+
+		bits = (exponent << 10) | (word & 0x3FF);
+	} while ((interval == RANDOM_OPEN_OPEN) && (bits == 0));
+
+	if (interval == RANDOM_OPEN_CLOSED)
+		++bits;
+
+	return static_cast<unsigned short>(bits);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           DrawExponent
+
+Description:    Biased exponent of a full precision unit number. Each leading
+				zero bit halves the number (exponent - 1); when every bit is 0
+				more words are drawn. Stops at 0, the subnormal numbers.
+
+Arguments:      bits:		random bits (the low width bits are used).
+				width:		number of random bits.
+				exponent:	biased exponent of [0.5, 1).
+
+Returns:        int:		Biased exponent [0, exponent].
+*---------------------------------------------------------------------------*/
+int Random::DrawExponent(unsigned int bits, int width, int exponent)
+{
+	for (;;)
+	{
+		if (bits != 0)
+		{
+			exponent -= LeadingZeros(bits, width);
+
+			return (exponent > 0) ? exponent : 0;
+		}
+
+		exponent -= width;
+
+		if (exponent <= 0)
+			return 0;
+
+		bits = NextBits();
+		width = 32;
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           DrawStandardNormals
+
+Description:    Standard normal numbers for the batch APIs. Each one uses its
+				own distribution like a scalar call, so the engine is used the
+				same way. Clamping tests z against -/+3 instead of the
+				transformed value against min/max, the two only differ by rounding.
+
+Arguments:      output:		buffer of at least count values.
+				count:		number of values.
+				is_clamp:	reroll values outside [-3, 3].
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Random::DrawStandardNormals(float *output, int count, bool is_clamp)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		std::normal_distribution<float> distribution(0.0f, 1.0f);
+
+		float value = distribution(m_generator);
+
+		if (is_clamp)
+		{
+			unsigned int counter = 0;
+
+			while ((value < -3.0f) || (value > 3.0f))
+			{
+				value = distribution(m_generator);
+				++counter;
+
+				ASSERT_MSG(counter < 10, "Can't produce normal distribution random number");
+			}
+
+			RANDOM_STAT_REROLL(counter);
+		}
+
+		output[i] = value;
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           ReplayDraw
+
+Description:    Serve a draw from a replaying log instead of the engine.
+				The logged API must match the call, otherwise the code path has
+				diverged from the recorded run.
+
+Arguments:      api:		API that is drawing.
+				result:		logged result.
+
+Returns:        bool:		False if the log is not replaying (or is exhausted).
+*---------------------------------------------------------------------------*/
+bool Random::ReplayDraw(RandomApi api, DrawValue &result)
+{
+	if (m_log->GetMode() != DRAWLOG_REPLAY)
+		return false;
+
+	DrawRecord record;
+	bool has_record = m_log->Next(record);
+
+	ASSERT_MSG(has_record, "Draw log is exhausted");
+
+	if (!has_record)
+		return false;
+
+	ASSERT_MSG(record.api == api, "Draw log diverged from the recorded run");
+
+	result = record.result;
+
+	return true;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           RecordDraw
+
+Description:    Append a draw to a recording log.
+
+Arguments:      api:		API that is drawing.
+				result:		result of the draw.
+				arg0~arg3:	arguments in declaration order.
+				flags:		DRAWLOG_FLAG_* of boolean arguments.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Random::RecordDraw(RandomApi api, DrawValue result, DrawValue arg0, DrawValue arg1, DrawValue arg2, DrawValue arg3, unsigned char flags)
+{
+	if (m_log->GetMode() != DRAWLOG_RECORD)
+		return;
+
+	DrawRecord record;
+	record.api = static_cast<unsigned char>(api);
+	record.flags = flags;
+	record.reserved = 0;
+	record.args[0] = arg0;
+	record.args[1] = arg1;
+	record.args[2] = arg2;
+	record.args[3] = arg3;
+	record.result = result;
+
+	m_log->Append(record);
+}
+
+#ifdef RANDOM_INSTRUMENTATION
+
+/*--------------------------------------------------------------------------*
+Name:           CountDraw
+
+Description:    Count draws of an API on this instance and thread.
+
+Arguments:      api:	API that is drawing.
+				count:	number of draws.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Random::CountDraw(RandomApi api, unsigned long long count)
+{
+	m_counters.draws[api].Increment(count);
+	g_random_thread_stats.draws[api] += count;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           CountRerolls
+
+Description:    Count the rejection-loop iterations of one NormalRange call.
+
+Arguments:      count:	number of rerolls.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Random::CountRerolls(unsigned int count)
+{
+	int bucket = (std::min)(static_cast<int>(count), RANDOM_REROLL_BUCKETS - 1);
+
+	m_counters.rerolls.Increment(count);
+	m_counters.reroll_histogram[bucket].Increment();
+	g_random_thread_stats.rerolls += count;
+	++g_random_thread_stats.reroll_histogram[bucket];
+}
+
+/*--------------------------------------------------------------------------*
+Name:           CountReseed
+
+Description:    Count one seeding of the engine.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Random::CountReseed(void)
+{
+	m_counters.reseeds.Increment();
+	++g_random_thread_stats.reseeds;
+}
+
+#endif
\ No newline at end of file
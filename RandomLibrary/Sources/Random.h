@@ -15,6 +15,10 @@ written consent of DigiPen Institute of Technology is prohibited.
 
 #include <random>
 
+#include "DrawLog.h"
+#include "FloatBits.h"
+#include "RandomStats.h"
+
 // static variables
 
 static const int DEFAULT_UNI_MIN_I = 0;
@@ -27,6 +31,24 @@ static const float DEFAULT_NOR_MIN = DEFAULT_NOR_MEAN - DEFAULT_NOR_STDDEV * 3.0
 static const float DEFAULT_NOR_MAX = DEFAULT_NOR_MEAN + DEFAULT_NOR_STDDEV * 3.0f;
 static const float DEFAULT_BER_PERC = 0.5f;
 
+// words drawn ahead for the unit numbers (see UnitFloat)
+// a multiple of 3, an engine narrower than 32 bits makes 3 words at a time
+static const int RANDOM_UNIT_WORDS = 48;
+
+/*
+	RANDOM_INSTRUMENTATION changes the layout of Random (engine type and
+	counters), so the library and every project that includes this header
+	must be built with the same setting, like the Instrumented configuration
+	of both projects. MSVC refuses to link objects that disagree.
+*/
+#ifdef _MSC_VER
+#ifdef RANDOM_INSTRUMENTATION
+#pragma detect_mismatch("RANDOM_INSTRUMENTATION", "1")
+#else
+#pragma detect_mismatch("RANDOM_INSTRUMENTATION", "0")
+#endif
+#endif
+
 class Random
 {
 public:
@@ -94,13 +116,154 @@ public:
 	// returns true/false based on percentage (Bernoulli distribution)
 	bool CoinToss(float percentage = DEFAULT_BER_PERC);
 
+	// Returns 32 uniformly distributed random bits
+	unsigned int RawBits(void);
+
+	// Fills output with count words of 32 random bits (same sequence as calling RawBits count times)
+	void FillRawBits(unsigned int *output, int count);
+
+	/* from raw bits */
+
+	// uniform number in interval built straight from 32-bit words (see FloatBits.h),
+	// is_full_precision also draws the exponent so every number of the format in the
+	// interval can come out, the dense ones near 0 included
+	// words per number: float 1, double 2, half 1 (full precision: about the same,
+	// plus one more for 1 float in 512 and 1 double in 4096)
+	// the words come from a block of RANDOM_UNIT_WORDS drawn ahead and shared by every
+	// function below, so they are not the words RawBits would return, and other draws
+	// made in between skip the words already in the block (still the same sequence per seed)
+
+	float UnitFloat(RandomInterval interval = RANDOM_CLOSED_OPEN, bool is_full_precision = false);
+	double UnitDouble(RandomInterval interval = RANDOM_CLOSED_OPEN, bool is_full_precision = false);
+
+	// half as its IEEE 754 bits (HalfToFloat reads it)
+	unsigned short UnitHalf(RandomInterval interval = RANDOM_CLOSED_OPEN, bool is_full_precision = false);
+
+	// min + unit number * (max - min), an end interval excludes never comes out even after rounding
+	// (RangeFloat(min, max) can return max)
+
+	float RangeFloat(float min, float max, RandomInterval interval);
+	double RangeDouble(double min, double max, RandomInterval interval = RANDOM_CLOSED_OPEN);
+	unsigned short RangeHalf(float min, float max, RandomInterval interval = RANDOM_CLOSED_OPEN);
+
+	/* bulk */
+
+	// fill output with count values, same sequence as calling the scalar function count times
+
+	void FillInt(int *output, int count, int min = DEFAULT_UNI_MIN_I, int max = DEFAULT_UNI_MAX_I);
+	void FillFloat(float *output, int count, float min = DEFAULT_UNI_MIN_F, float max = DEFAULT_UNI_MAX_F);
+	void FillUnitFloat(float *output, int count, RandomInterval interval = RANDOM_CLOSED_OPEN, bool is_full_precision = false);
+	void FillUnitDouble(double *output, int count, RandomInterval interval = RANDOM_CLOSED_OPEN, bool is_full_precision = false);
+	void FillNormal(float *output, int count,
+		float mean = DEFAULT_NOR_MEAN,
+		float stddev = DEFAULT_NOR_STDDEV,
+		bool is_clamp = true,
+		bool calculate_minmax = true,
+		float min = DEFAULT_NOR_MIN,
+		float max = DEFAULT_NOR_MAX);
+
+	// batch with per-element parameters, output[i] follows the scalar function with min[i], max[i] (or mean[i], stddev[i])
+	// the affine transform (and clamp) of the whole batch runs in SIMD
+
+	void RangeFloats(float *output, const float *min, const float *max, int count);
+	void NormalRanges(float *output, const float *mean, const float *stddev, int count, bool is_clamp = true);
+	void NormalRangesMinMax(float *output, const float *min, const float *max, int count);
+
+	/* instrumentation */
+
+	// counters stay zero unless RANDOM_INSTRUMENTATION is defined
+
+	// snapshot of counters of this instance
+	RandomStats GetStats(void) const;
+
+	// set counters of this instance to zero
+	void ResetStats(void);
+
+	// snapshot of counters of the calling thread (every instance used on it)
+	static RandomStats GetThreadStats(void);
+
+	// set counters of the calling thread to zero
+	static void ResetThreadStats(void);
+
+	// copy g_random call sites of the calling thread, busiest first
+	// returns number of call sites written
+	static int GetThreadCallSites(RandomCallSite *output, int max_count);
+
+	// count one evaluation of g_random at file:line (see Global.h)
+	Random &AtCallSite(const char *file, int line);
+
+	/* record/replay */
+
+	// attach a draw log (NULL to detach)
+	// a recording log gets every draw appended, a replaying log serves every draw instead of the engine
+	void SetDrawLog(DrawLog *log)			{ m_log = log; }
+	DrawLog *GetDrawLog(void)				{ return m_log; }
+
 private:
 
+	/* helper functions */
+
+	// NormalRange without logging
+	float DrawNormal(float mean, float stddev, bool is_clamp, bool calculate_minmax, float min, float max);
+
+	// RawBits without counting or logging
+	unsigned int DrawBits(void);
+
+	// next word of the unit block, logged as a RawBits draw when a log is attached
+	unsigned int NextBits(void);
+
+	// NextBits when the unit block is used up or a log is attached
+	unsigned int DrawUnitWord(void);
+
+	// draw RANDOM_UNIT_WORDS new words into the unit block
+	void RefillUnitWords(void);
+
+	// UnitFloat/UnitDouble/UnitHalf without counting
+	float DrawUnitFloat(RandomInterval interval, bool is_full_precision);
+	double DrawUnitDouble(RandomInterval interval, bool is_full_precision);
+	unsigned short DrawUnitHalf(RandomInterval interval, bool is_full_precision);
+
+	// biased exponent of a full precision unit number from the leading zeros of bits (width wide)
+	int DrawExponent(unsigned int bits, int width, int exponent);
+
+	// standard normal numbers, rerolled outside [-3, 3] if clamped (the batch part of NormalRanges)
+	void DrawStandardNormals(float *output, int count, bool is_clamp);
+
+	// serve a draw from a replaying log, returns false if not replaying
+	bool ReplayDraw(RandomApi api, DrawValue &result);
+
+	// append a draw to a recording log
+	void RecordDraw(RandomApi api, DrawValue result,
+		DrawValue arg0, DrawValue arg1 = DrawValue(), DrawValue arg2 = DrawValue(), DrawValue arg3 = DrawValue(),
+		unsigned char flags = 0);
+
+#ifdef RANDOM_INSTRUMENTATION
+	void CountDraw(RandomApi api, unsigned long long count = 1);
+	void CountRerolls(unsigned int count);
+	void CountReseed(void);
+#endif
+
 	/* variables */
 
+#ifdef RANDOM_INSTRUMENTATION
+	typedef CountingEngine<std::default_random_engine> Engine;
+
+	// instrumentation counters
+	RandomCounters m_counters;
+#else
+	typedef std::default_random_engine Engine;
+#endif
+
 	// Pseudo-random number engine
-	std::default_random_engine m_generator;
+	Engine m_generator;
 
 	// default seed value
 	unsigned int m_seed;
+
+	// attached draw log (not owned)
+	DrawLog *m_log;
+
+	// words for the unit numbers, m_unit_words[m_unit_next ~ RANDOM_UNIT_WORDS - 1] are unused
+	unsigned int m_unit_words[RANDOM_UNIT_WORDS];
+	int m_unit_next;
 };
\ No newline at end of file
@@ -0,0 +1,556 @@
+/******************************************************************************/
+/*!
+\file		RandomArray.cpp
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Compact random number streams for many entities.
+			xoshiro128** per entity, state words in separate arrays
+			so SSE2 steps 4 entities at once.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "RandomArray.h"
+#include "MyAssert.h"
+#include "SIMD.h"
+
+// static variables
+
+// entities per block of the bulk functions
+static const int RANDOM_ARRAY_BLOCK = 256;
+
+// polynomials over GF(2) of the xoshiro128** state transition, bit j of word j / 32 is x^j
+
+// x^(2^64) mod the characteristic polynomial, one jump of 2^64 draws (from the reference jump())
+static const unsigned int RANDOM_ARRAY_JUMP[4] = { 0x8764000Bu, 0xF542D2D3u, 0x6FA035C3u, 0x77F2DB5Bu };
+
+// characteristic polynomial without its x^128 term
+static const unsigned int RANDOM_ARRAY_CHARACTERISTIC[4] = { 0xDE18FC01u, 0x1B489DB6u, 0x006254B1u, 0x00FC65A2u };
+
+// helper functions
+
+/*--------------------------------------------------------------------------*
+Name:           Mix
+
+Description:    64-bit finalizer (splitmix64), every input bit affects every output bit.
+
+Arguments:      value:					value to mix.
+
+Returns:        unsigned long long:		Mixed value.
+*---------------------------------------------------------------------------*/
+static inline unsigned long long Mix(unsigned long long value)
+{
+	value ^= value >> 30;
+	value *= 0xBF58476D1CE4E5B9ull;
+	value ^= value >> 27;
+	value *= 0x94D049BB133111EBull;
+	value ^= value >> 31;
+
+	return value;
+}
+
+// rotate left by bits [1, 31]
+static inline unsigned int RotateLeft(unsigned int value, int bits)
+{
+	return (value << bits) | (value >> (32 - bits));
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Step
+
+Description:    Advance one xoshiro128** state.
+
+Arguments:      s0 ~ s3:		state words, updated.
+
+Returns:        unsigned int:	32 random bits.
+*---------------------------------------------------------------------------*/
+static inline unsigned int Step(unsigned int &s0, unsigned int &s1, unsigned int &s2, unsigned int &s3)
+{
+	unsigned int result = RotateLeft(s1 * 5, 7) * 9;
+	unsigned int t = s1 << 9;
+
+	s2 ^= s0;
+	s3 ^= s1;
+	s1 ^= s2;
+	s0 ^= s3;
+	s2 ^= t;
+	s3 = RotateLeft(s3, 11);
+
+	return result;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           MultiplyJump
+
+Description:    Product of two jump polynomials mod the characteristic
+				polynomial (shift and add, one bit of rhs at a time).
+
+Arguments:      result:		product, may be lhs or rhs.
+				lhs:		first polynomial.
+				rhs:		second polynomial.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+static void MultiplyJump(unsigned int *result, const unsigned int *lhs, const unsigned int *rhs)
+{
+	unsigned int product[4] = { 0, 0, 0, 0 };
+
+	for (int bit = 127; bit >= 0; --bit)
+	{
+		// product * x, x^128 is replaced by the rest of the characteristic polynomial
+
+		unsigned int carry = product[3] >> 31;
+
+		product[3] = (product[3] << 1) | (product[2] >> 31);
+		product[2] = (product[2] << 1) | (product[1] >> 31);
+		product[1] = (product[1] << 1) | (product[0] >> 31);
+		product[0] <<= 1;
+
+		for (int k = 0; k < 4; ++k)
+		{
+			if (carry)
+				product[k] ^= RANDOM_ARRAY_CHARACTERISTIC[k];
+			if ((rhs[bit >> 5] >> (bit & 31)) & 1)
+				product[k] ^= lhs[k];
+		}
+	}
+
+	for (int k = 0; k < 4; ++k)
+		result[k] = product[k];
+}
+
+#ifdef RANDOM_USE_SSE2
+// rotate 4 lanes left by bits [1, 31]
+#define RANDOM_ARRAY_ROTL(value, bits)	_mm_or_si128(_mm_slli_epi32(value, bits), _mm_srli_epi32(value, 32 - (bits)))
+#endif
+
+/*--------------------------------------------------------------------------*
+Name:           UniformFloat
+
+Description:    Uniform float [0, 1) from the top 24 bits (every float step
+				in [0, 1) at that spacing is exact).
+
+Arguments:      bits:		random word.
+
+Returns:        float:		Random number [0, 1).
+*---------------------------------------------------------------------------*/
+static inline float UniformFloat(unsigned int bits)
+{
+	return static_cast<float>(static_cast<int>(bits >> 8)) * (1.0f / 16777216.0f);
+}
+
+// CoinToss is true when the random word is below this
+static inline unsigned long long CoinThreshold(float percentage)
+{
+	return static_cast<unsigned long long>(static_cast<double>(percentage) * 4294967296.0);
+}
+
+// public functions
+
+/*--------------------------------------------------------------------------*
+Name:           RandomArray
+
+Description:    Constructor.
+
+Arguments:      count:		number of entities.
+				seed:		seed of every entity.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+RandomArray::RandomArray(int count, unsigned int seed)
+	: m_s0(count), m_s1(count), m_s2(count), m_s3(count)
+{
+	ASSERT_MSG(count >= 0, "Entity count should be >= 0");
+
+	SetSeed(seed);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           ~RandomArray
+
+Description:    Destructor.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+RandomArray::~RandomArray()
+{
+}
+
+/*--------------------------------------------------------------------------*
+Name:           SetSeed
+
+Description:    Reseed every entity. Entity i's state is splitmix64 of
+				(seed, i), which is never all zero (the one state xoshiro
+				cannot leave).
+
+Arguments:      seed:		seed of every entity.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void RandomArray::SetSeed(unsigned int seed)
+{
+	static const unsigned long long GOLDEN = 0x9E3779B97F4A7C15ull;
+
+	m_seed = seed;
+
+	for (int i = 0; i < GetCount(); ++i)
+	{
+		unsigned long long key = (static_cast<unsigned long long>(seed) << 32) | static_cast<unsigned int>(i);
+		unsigned long long low = Mix(key + GOLDEN);
+		unsigned long long high = Mix(key + GOLDEN * 2);
+
+		m_s0[i] = static_cast<unsigned int>(low);
+		m_s1[i] = static_cast<unsigned int>(low >> 32);
+		m_s2[i] = static_cast<unsigned int>(high);
+		m_s3[i] = static_cast<unsigned int>(high >> 32);
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Jump
+
+Description:    Advance every entity by count * 2^64 draws. The polynomial
+				x^(count * 2^64) mod the characteristic polynomial is the
+				jump polynomial to the power count (square and multiply),
+				then each entity sums the states of its next 128 steps
+				picked by that polynomial, like the reference jump().
+
+Arguments:      count:		number of 2^64-draw jumps.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void RandomArray::Jump(unsigned long long count)
+{
+	if (count == 0)
+		return;
+
+	unsigned int poly[4] = { 1, 0, 0, 0 };
+	unsigned int power[4] = { RANDOM_ARRAY_JUMP[0], RANDOM_ARRAY_JUMP[1], RANDOM_ARRAY_JUMP[2], RANDOM_ARRAY_JUMP[3] };
+
+	for (; count; count >>= 1)
+	{
+		if (count & 1)
+			MultiplyJump(poly, poly, power);
+
+		if (count > 1)
+			MultiplyJump(power, power, power);
+	}
+
+	for (int i = 0; i < GetCount(); ++i)
+	{
+		unsigned int t0 = 0, t1 = 0, t2 = 0, t3 = 0;
+
+		for (int bit = 0; bit < 128; ++bit)
+		{
+			if ((poly[bit >> 5] >> (bit & 31)) & 1)
+			{
+				t0 ^= m_s0[i];
+				t1 ^= m_s1[i];
+				t2 ^= m_s2[i];
+				t3 ^= m_s3[i];
+			}
+
+			Step(m_s0[i], m_s1[i], m_s2[i], m_s3[i]);
+		}
+
+		m_s0[i] = t0;
+		m_s1[i] = t1;
+		m_s2[i] = t2;
+		m_s3[i] = t3;
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           GetMemory
+
+Description:    Bytes of generator state, 16 per entity.
+
+Arguments:      None.
+
+Returns:        size_t:		Bytes.
+*---------------------------------------------------------------------------*/
+size_t RandomArray::GetMemory(void) const
+{
+	return sizeof(unsigned int) * (m_s0.capacity() + m_s1.capacity() + m_s2.capacity() + m_s3.capacity());
+}
+
+/*--------------------------------------------------------------------------*
+Name:           RawBits
+
+Description:    32 uniformly distributed random bits from one entity.
+
+Arguments:      index:			entity index.
+
+Returns:        unsigned int:	Random bits.
+*---------------------------------------------------------------------------*/
+unsigned int RandomArray::RawBits(int index)
+{
+	ASSERT_MSG((index >= 0) && (index < GetCount()), "Random array index is out of range");
+
+	return Step(m_s0[index], m_s1[index], m_s2[index], m_s3[index]);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           RangeInt
+
+Description:    Uniform distribution random integer from one entity.
+				Multiply-shift range reduction, with the rare biased words
+				rerolled from the same entity.
+
+Arguments:      index:		entity index.
+				min:		lower boundry.
+				max:		upper boundry.
+
+Returns:        int:		Random number [min, max].
+*---------------------------------------------------------------------------*/
+int RandomArray::RangeInt(int index, int min, int max)
+{
+	ASSERT_MSG(max >= min, "Max should be >= min");
+
+	unsigned int range = static_cast<unsigned int>(max) - static_cast<unsigned int>(min) + 1;
+	unsigned int bits = RawBits(index);
+
+	// [INT_MIN, INT_MAX] is every word
+
+	if (range == 0)
+		return static_cast<int>(bits);
+
+	unsigned long long product = static_cast<unsigned long long>(bits) * range;
+
+	if (static_cast<unsigned int>(product) < range)
+	{
+		unsigned int threshold = (0u - range) % range;
+
+		while (static_cast<unsigned int>(product) < threshold)
+			product = static_cast<unsigned long long>(RawBits(index)) * range;
+	}
+
+	return static_cast<int>(static_cast<unsigned int>(min) + static_cast<unsigned int>(product >> 32));
+}
+
+/*--------------------------------------------------------------------------*
+Name:           RangeFloat
+
+Description:    Uniform distribution random float number from one entity.
+
+Arguments:      index:		entity index.
+				min:		lower boundry.
+				max:		upper boundry.
+
+Returns:        float:		Random number [min, max).
+*---------------------------------------------------------------------------*/
+float RandomArray::RangeFloat(int index, float min, float max)
+{
+	ASSERT_MSG(max >= min, "Max should be >= min");
+
+	return UniformFloat(RawBits(index)) * (max - min) + min;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           CoinToss
+
+Description:    Bernoulli distribution random boolean from one entity.
+
+Arguments:      index:		entity index.
+				percentage:	chance of true [0, 1].
+
+Returns:        bool:		true or false.
+*---------------------------------------------------------------------------*/
+bool RandomArray::CoinToss(int index, float percentage)
+{
+	ASSERT_MSG((percentage <= 1.0f) && (percentage >= 0.0f), "Percentage should be [0-1]");
+
+	return (RawBits(index) < CoinThreshold(percentage));
+}
+
+/*--------------------------------------------------------------------------*
+Name:           FillRawBits
+
+Description:    Step every entity once, output[i] is what RawBits(i) would
+				have returned.
+
+Arguments:      output:		buffer of at least GetCount words.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void RandomArray::FillRawBits(unsigned int *output)
+{
+	StepRange(output, 0, GetCount());
+}
+
+/*--------------------------------------------------------------------------*
+Name:           FillInt
+
+Description:    One uniform random integer per entity, output[i] is what
+				RangeInt(i, min, max) would have returned.
+
+Arguments:      output:		buffer of at least GetCount numbers.
+				min:		lower boundry.
+				max:		upper boundry.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void RandomArray::FillInt(int *output, int min, int max)
+{
+	ASSERT_MSG(max >= min, "Max should be >= min");
+
+	// int and unsigned int may alias, the words are mapped in place
+
+	unsigned int *bits = reinterpret_cast<unsigned int *>(output);
+	unsigned int range = static_cast<unsigned int>(max) - static_cast<unsigned int>(min) + 1;
+
+	FillRawBits(bits);
+
+	if (range == 0)
+		return;
+
+	unsigned int threshold = (0u - range) % range;
+
+	for (int i = 0; i < GetCount(); ++i)
+	{
+		unsigned long long product = static_cast<unsigned long long>(bits[i]) * range;
+
+		while (static_cast<unsigned int>(product) < threshold)
+			product = static_cast<unsigned long long>(RawBits(i)) * range;
+
+		bits[i] = static_cast<unsigned int>(min) + static_cast<unsigned int>(product >> 32);
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           FillFloat
+
+Description:    One uniform random float number per entity, output[i] is
+				what RangeFloat(i, min, max) would have returned.
+
+Arguments:      output:		buffer of at least GetCount numbers.
+				min:		lower boundry.
+				max:		upper boundry.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void RandomArray::FillFloat(float *output, float min, float max)
+{
+	ASSERT_MSG(max >= min, "Max should be >= min");
+
+	unsigned int bits[RANDOM_ARRAY_BLOCK];
+	float range = max - min;
+
+	for (int i = 0; i < GetCount(); i += RANDOM_ARRAY_BLOCK)
+	{
+		int block = (GetCount() - i < RANDOM_ARRAY_BLOCK) ? (GetCount() - i) : RANDOM_ARRAY_BLOCK;
+		int j = 0;
+
+		StepRange(bits, i, block);
+
+#ifdef RANDOM_USE_SSE2
+		__m128 scale = _mm_set1_ps(1.0f / 16777216.0f);
+		__m128 width = _mm_set1_ps(range);
+		__m128 low = _mm_set1_ps(min);
+
+		for (; j + 4 <= block; j += 4)
+		{
+			__m128i word = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(bits + j)), 8);
+			__m128 uniform = _mm_mul_ps(_mm_cvtepi32_ps(word), scale);
+
+			_mm_storeu_ps(output + i + j, _mm_add_ps(_mm_mul_ps(uniform, width), low));
+		}
+#endif
+
+		for (; j < block; ++j)
+			output[i + j] = UniformFloat(bits[j]) * range + min;
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           FillCoinToss
+
+Description:    One random boolean per entity, output[i] is what
+				CoinToss(i, percentage) would have returned.
+
+Arguments:      output:		buffer of at least GetCount booleans.
+				percentage:	chance of true [0, 1].
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void RandomArray::FillCoinToss(bool *output, float percentage)
+{
+	ASSERT_MSG((percentage <= 1.0f) && (percentage >= 0.0f), "Percentage should be [0-1]");
+
+	unsigned int bits[RANDOM_ARRAY_BLOCK];
+	unsigned long long threshold = CoinThreshold(percentage);
+
+	for (int i = 0; i < GetCount(); i += RANDOM_ARRAY_BLOCK)
+	{
+		int block = (GetCount() - i < RANDOM_ARRAY_BLOCK) ? (GetCount() - i) : RANDOM_ARRAY_BLOCK;
+
+		StepRange(bits, i, block);
+
+		for (int j = 0; j < block; ++j)
+			output[i + j] = (bits[j] < threshold);
+	}
+}
+
+// private functions
+
+/*--------------------------------------------------------------------------*
+Name:           StepRange
+
+Description:    Step entities first ~ first + count - 1 once, 4 at a time with SSE2.
+
+Arguments:      output:		buffer of at least count words, output[i] is for entity first + i.
+				first:		first entity.
+				count:		number of entities.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void RandomArray::StepRange(unsigned int *output, int first, int count)
+{
+	int i = 0;
+
+	if (count == 0)
+		return;
+
+	unsigned int *s0 = &m_s0[first];
+	unsigned int *s1 = &m_s1[first];
+	unsigned int *s2 = &m_s2[first];
+	unsigned int *s3 = &m_s3[first];
+
+#ifdef RANDOM_USE_SSE2
+	// SSE2 has no 32-bit multiply, x * 5 and x * 9 are shifts and adds
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s0 + i));
+		__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s1 + i));
+		__m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s2 + i));
+		__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s3 + i));
+
+		__m128i times5 = _mm_add_epi32(_mm_slli_epi32(b, 2), b);
+		__m128i rotated = RANDOM_ARRAY_ROTL(times5, 7);
+		__m128i result = _mm_add_epi32(_mm_slli_epi32(rotated, 3), rotated);
+		__m128i t = _mm_slli_epi32(b, 9);
+
+		c = _mm_xor_si128(c, a);
+		d = _mm_xor_si128(d, b);
+		b = _mm_xor_si128(b, c);
+		a = _mm_xor_si128(a, d);
+		c = _mm_xor_si128(c, t);
+		d = RANDOM_ARRAY_ROTL(d, 11);
+
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(s0 + i), a);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(s1 + i), b);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(s2 + i), c);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(s3 + i), d);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(output + i), result);
+	}
+#endif
+
+	for (; i < count; ++i)
+		output[i] = Step(s0[i], s1[i], s2[i], s3[i]);
+}
@@ -0,0 +1,90 @@
+/******************************************************************************/
+/*!
+\file		RandomArray.h
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Compact random number streams for many entities.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "Random.h"
+
+/*
+	One xoshiro128** generator per entity, 16 bytes of state each (a Random
+	carries a whole std::default_random_engine). The four state words are kept
+	in separate arrays, so the bulk functions step 4 entities per SSE2
+	instruction; xoshiro128** only needs shifts, xors and adds for that.
+
+	Entity i's stream depends only on the seed and i, and the per-index and
+	bulk functions draw from it the same way, so an entity sees the same
+	numbers however its draws are batched.
+*/
+class RandomArray
+{
+public:
+
+	/* constructor/destructor */
+
+	// constructor, count entities seeded from seed
+	RandomArray(int count, unsigned int seed);
+
+	// destructor
+	~RandomArray();
+
+	/* getter/setter */
+
+	int GetCount(void) const								{ return static_cast<int>(m_s0.size()); }
+	unsigned int GetSeed(void) const						{ return m_seed; }
+
+	// reseed every entity
+	void SetSeed(unsigned int seed);
+
+	// advance every entity by count * 2^64 draws (xoshiro128** jump), so streams of
+	// one seed jumped a different number of times never overlap within 2^64 draws
+	void Jump(unsigned long long count);
+
+	// bytes of generator state
+	size_t GetMemory(void) const;
+
+	/* methods */
+
+	// one draw for entity index (same ranges as Random)
+
+	unsigned int RawBits(int index);
+	int RangeInt(int index, int min = DEFAULT_UNI_MIN_I, int max = DEFAULT_UNI_MAX_I);
+	float RangeFloat(int index, float min = DEFAULT_UNI_MIN_F, float max = DEFAULT_UNI_MAX_F);
+	bool CoinToss(int index, float percentage = DEFAULT_BER_PERC);
+
+	// one draw for every entity, output[i] is for entity i (buffer of at least GetCount values)
+
+	void FillRawBits(unsigned int *output);
+	void FillInt(int *output, int min = DEFAULT_UNI_MIN_I, int max = DEFAULT_UNI_MAX_I);
+	void FillFloat(float *output, float min = DEFAULT_UNI_MIN_F, float max = DEFAULT_UNI_MAX_F);
+	void FillCoinToss(bool *output, float percentage = DEFAULT_BER_PERC);
+
+private:
+
+	/* helper functions */
+
+	// step entities first ~ first + count - 1, output[i] is for entity first + i
+	void StepRange(unsigned int *output, int first, int count);
+
+	/* variables */
+
+	// seed of every entity
+	unsigned int m_seed;
+
+	// xoshiro128** state words of each entity
+	std::vector<unsigned int> m_s0;
+	std::vector<unsigned int> m_s1;
+	std::vector<unsigned int> m_s2;
+	std::vector<unsigned int> m_s3;
+};
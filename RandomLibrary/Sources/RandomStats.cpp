@@ -0,0 +1,176 @@
+/******************************************************************************/
+/*!
+\file		RandomStats.cpp
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Opt-in instrumentation counters for Random.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <sstream>
+
+#include "RandomStats.h"
+
+// static variables
+
+// names of RandomApi values for export
+static const char *RANDOM_API_NAMES[RANDOM_API_COUNT] =
+{
+	"RangeInt",
+	"RangeFloat",
+	"NormalRange",
+	"NormalRangeMinMax",
+	"CoinToss",
+	"RawBits",
+	"UnitFloat",
+	"UnitDouble",
+	"UnitHalf",
+	"RangeDouble",
+	"RangeHalf"
+};
+
+// global variables
+
+RANDOM_THREAD_LOCAL RandomStats g_random_thread_stats;
+
+// public functions
+
+/*--------------------------------------------------------------------------*
+Name:           Clear
+
+Description:    Set every counter to zero.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void RandomStats::Clear(void)
+{
+	for (int i = 0; i < RANDOM_API_COUNT; ++i)
+		draws[i] = 0;
+
+	for (int i = 0; i < RANDOM_REROLL_BUCKETS; ++i)
+		reroll_histogram[i] = 0;
+
+	raw_words = 0;
+	rerolls = 0;
+	reseeds = 0;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           operator+=
+
+Description:    Add counters of another snapshot (e.g. to merge threads).
+
+Arguments:      rhs:			snapshot to add.
+
+Returns:        RandomStats&:	This snapshot.
+*---------------------------------------------------------------------------*/
+RandomStats &RandomStats::operator+=(const RandomStats &rhs)
+{
+	for (int i = 0; i < RANDOM_API_COUNT; ++i)
+		draws[i] += rhs.draws[i];
+
+	for (int i = 0; i < RANDOM_REROLL_BUCKETS; ++i)
+		reroll_histogram[i] += rhs.reroll_histogram[i];
+
+	raw_words += rhs.raw_words;
+	rerolls += rhs.rerolls;
+	reseeds += rhs.reseeds;
+
+	return *this;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           TotalDraws
+
+Description:    Total draws of every API.
+
+Arguments:      None.
+
+Returns:        unsigned long long:	Number of draws.
+*---------------------------------------------------------------------------*/
+unsigned long long RandomStats::TotalDraws(void) const
+{
+	unsigned long long total = 0;
+
+	for (int i = 0; i < RANDOM_API_COUNT; ++i)
+		total += draws[i];
+
+	return total;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           ToString
+
+Description:    Export counters as readable text, one "name: value" per line.
+
+Arguments:      None.
+
+Returns:        std::string:	Counters as text.
+*---------------------------------------------------------------------------*/
+std::string RandomStats::ToString(void) const
+{
+	std::ostringstream output;
+
+	for (int i = 0; i < RANDOM_API_COUNT; ++i)
+		output << RANDOM_API_NAMES[i] << ": " << draws[i] << "\n";
+
+	output << "raw words: " << raw_words << "\n";
+	output << "rerolls: " << rerolls << "\n";
+
+	for (int i = 0; i < RANDOM_REROLL_BUCKETS; ++i)
+	{
+		output << "rerolls " << i << ((i == RANDOM_REROLL_BUCKETS - 1) ? "+" : "") << ": " << reroll_histogram[i] << "\n";
+	}
+
+	output << "reseeds: " << reseeds << "\n";
+
+	return output.str();
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Snapshot
+
+Description:    Copy counters into a snapshot. Safe to call from any thread.
+
+Arguments:      stats:	snapshot to write.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void RandomCounters::Snapshot(RandomStats &stats) const
+{
+	for (int i = 0; i < RANDOM_API_COUNT; ++i)
+		stats.draws[i] = draws[i].Get();
+
+	for (int i = 0; i < RANDOM_REROLL_BUCKETS; ++i)
+		stats.reroll_histogram[i] = reroll_histogram[i].Get();
+
+	stats.rerolls = rerolls.Get();
+	stats.reseeds = reseeds.Get();
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Reset
+
+Description:    Set every counter to zero.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void RandomCounters::Reset(void)
+{
+	for (int i = 0; i < RANDOM_API_COUNT; ++i)
+		draws[i].Set(0);
+
+	for (int i = 0; i < RANDOM_REROLL_BUCKETS; ++i)
+		reroll_histogram[i].Set(0);
+
+	rerolls.Set(0);
+	reseeds.Set(0);
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+/******************************************************************************/
+/*!
+\file		RandomStats.h
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Opt-in instrumentation counters for Random.
+			Define RANDOM_INSTRUMENTATION in the preprocessor definitions
+			to enable, otherwise every counter is compiled out.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <random>
+#include <string>
+
+// compiler compatibility
+
+// VS2013 has neither constexpr nor thread_local
+#if defined(_MSC_VER) && (_MSC_VER < 1900)
+#define RANDOM_CONSTEXPR
+#else
+#define RANDOM_CONSTEXPR constexpr
+#endif
+
+#if defined(_MSC_VER)
+#define RANDOM_THREAD_LOCAL __declspec(thread)
+#else
+#define RANDOM_THREAD_LOCAL __thread
+#endif
+
+// static variables
+
+// clamped normal draws are bucketed by number of rerolls, the last bucket is 10 or more
+static const int RANDOM_REROLL_BUCKETS = 11;
+
+// maximum number of g_random call sites tracked per thread
+static const int RANDOM_CALL_SITES = 256;
+
+// public API of Random that draws numbers
+enum RandomApi
+{
+	RANDOM_API_RANGE_INT,
+	RANDOM_API_RANGE_FLOAT,
+	RANDOM_API_NORMAL_RANGE,
+	RANDOM_API_NORMAL_RANGE_MINMAX,
+	RANDOM_API_COIN_TOSS,
+	RANDOM_API_RAW_BITS,				// counted per 32-bit word
+	RANDOM_API_UNIT_FLOAT,
+	RANDOM_API_UNIT_DOUBLE,
+	RANDOM_API_UNIT_HALF,
+	RANDOM_API_RANGE_DOUBLE,
+	RANDOM_API_RANGE_HALF,
+
+	RANDOM_API_COUNT
+};
+
+// snapshot of counters (plain data so it can live in thread local storage)
+struct RandomStats
+{
+	// draws per API
+	unsigned long long draws[RANDOM_API_COUNT];
+
+	// raw engine outputs consumed
+	unsigned long long raw_words;
+
+	// total rejection-loop iterations of clamped normal draws
+	unsigned long long rerolls;
+
+	// clamped NormalRange/NormalRangeMinMax draws by number of rerolls
+	unsigned long long reroll_histogram[RANDOM_REROLL_BUCKETS];
+
+	// number of times the engine was seeded
+	unsigned long long reseeds;
+
+	// set every counter to zero
+	void Clear(void);
+
+	// add counters of another snapshot
+	RandomStats &operator+=(const RandomStats &rhs);
+
+	// total draws of every API
+	unsigned long long TotalDraws(void) const;
+
+	// export as readable text, one counter per line
+	std::string ToString(void) const;
+};
+
+// number of g_random evaluations from one source line
+struct RandomCallSite
+{
+	const char *file;
+	int line;
+	unsigned long long count;
+};
+
+// counter owned by one thread and readable from any thread
+// increments are a relaxed load/store pair instead of a read-modify-write,
+// a plain mov on x64 (Win32 still needs lock cmpxchg8b for each 64-bit load and store)
+class RandomCounter
+{
+public:
+
+	RandomCounter() : m_value(0)								{}
+	RandomCounter(const RandomCounter &rhs) : m_value(rhs.Get())	{}
+
+	RandomCounter &operator=(const RandomCounter &rhs)		{ Set(rhs.Get()); return *this; }
+
+	unsigned long long Get(void) const						{ return m_value.load(std::memory_order_relaxed); }
+	void Set(unsigned long long value)						{ m_value.store(value, std::memory_order_relaxed); }
+	void Increment(unsigned long long amount = 1)			{ Set(Get() + amount); }
+
+private:
+
+	std::atomic<unsigned long long> m_value;
+};
+
+// per-instance counters of Random
+struct RandomCounters
+{
+	RandomCounter draws[RANDOM_API_COUNT];
+	RandomCounter rerolls;
+	RandomCounter reroll_histogram[RANDOM_REROLL_BUCKETS];
+	RandomCounter reseeds;
+
+	// copy counters into a snapshot (raw words are counted by the engine)
+	void Snapshot(RandomStats &stats) const;
+
+	// set every counter to zero
+	void Reset(void);
+};
+
+// counters of the calling thread, summed over every Random used on it
+extern RANDOM_THREAD_LOCAL RandomStats g_random_thread_stats;
+
+// engine adapter that counts raw outputs consumed by the distributions
+template <typename Engine>
+class CountingEngine
+{
+public:
+
+	typedef typename Engine::result_type result_type;
+
+	// parenthesized so the min/max macros of Windows.h do not expand
+	static RANDOM_CONSTEXPR result_type (min)()				{ return (Engine::min)(); }
+	static RANDOM_CONSTEXPR result_type (max)()				{ return (Engine::max)(); }
+
+	void seed(result_type value)							{ m_engine.seed(value); }
+
+	result_type operator()()
+	{
+		m_words.Increment();
+		++g_random_thread_stats.raw_words;
+
+		return m_engine();
+	}
+
+	unsigned long long GetWords(void) const					{ return m_words.Get(); }
+	void ResetWords(void)									{ m_words.Set(0); }
+
+private:
+
+	Engine m_engine;
+	RandomCounter m_words;
+};
+
+// instrumentation hooks used by Random
+
+#ifdef RANDOM_INSTRUMENTATION
+#define RANDOM_STAT_DRAW(api)		CountDraw(api)
+#define RANDOM_STAT_DRAWS(api, count)	CountDraw(api, count)
+#define RANDOM_STAT_REROLL(count)	CountRerolls(count)
+#define RANDOM_STAT_RESEED()		CountReseed()
+#else
+#define RANDOM_STAT_DRAW(api)
+#define RANDOM_STAT_DRAWS(api, count)
+#define RANDOM_STAT_REROLL(count)
+#define RANDOM_STAT_RESEED()
+#endif
\ No newline at end of file
@@ -0,0 +1,335 @@
+/******************************************************************************/
+/*!
+\file		RandomView.h
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Lazy views over Random distributions.
+			Values are pulled from Random in blocks through the bulk Fill
+			functions, so iterating is close to the speed of a bulk fill while
+			yielding exactly the values of the matching scalar calls.
+
+			for (int value : RandomInts(random, 0, 100) | Take(n) | Transform(f))
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "MyAssert.h"
+#include "Random.h"
+
+// static variables
+
+// values pulled from Random per refill
+static const int RANDOM_VIEW_BLOCK = 256;
+
+/* fills, one bulk call on Random per distribution */
+
+struct RandomIntFill
+{
+	int min;
+	int max;
+
+	void operator()(Random &random, int *output, int count) const
+	{
+		random.FillInt(output, count, min, max);
+	}
+};
+
+struct RandomFloatFill
+{
+	float min;
+	float max;
+
+	void operator()(Random &random, float *output, int count) const
+	{
+		random.FillFloat(output, count, min, max);
+	}
+};
+
+struct RandomNormalFill
+{
+	float mean;
+	float stddev;
+	bool is_clamp;
+
+	void operator()(Random &random, float *output, int count) const
+	{
+		random.FillNormal(output, count, mean, stddev, is_clamp);
+	}
+};
+
+/*
+	Single-pass view of values of one distribution.
+
+	A limited view (see Take) never draws more than its limit, so the draws
+	left on Random afterwards are the same as after the matching scalar loop.
+	An unlimited view draws up to RANDOM_VIEW_BLOCK values ahead.
+	Don't draw from the same Random while iterating, and adapt a view
+	before iterating it (a copy shares nothing with the original).
+*/
+template <typename T, typename Fill>
+class RandomView
+{
+public:
+
+	typedef T value_type;
+
+	class iterator
+	{
+	public:
+
+		typedef std::input_iterator_tag iterator_category;
+		typedef T value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const T *pointer;
+		typedef const T &reference;
+
+		iterator() : m_view(NULL)							{}
+		explicit iterator(RandomView *view) : m_view(view)	{}
+
+		const T &operator*() const							{ return m_view->Current(); }
+		iterator &operator++()								{ m_view->Advance(); return *this; }
+		void operator++(int)								{ m_view->Advance(); }
+
+		// iterators only compare as "at the end" or not
+		bool operator==(const iterator &rhs) const			{ return IsEnd() == rhs.IsEnd(); }
+		bool operator!=(const iterator &rhs) const			{ return IsEnd() != rhs.IsEnd(); }
+
+	private:
+
+		bool IsEnd(void) const								{ return !m_view || m_view->IsDone(); }
+
+		RandomView *m_view;
+	};
+
+	/* constructor */
+
+	// limit < 0 is unlimited
+	RandomView(Random &random, const Fill &fill, long long limit = -1) :
+		m_random(&random), m_fill(fill), m_remaining(limit), m_next(0), m_size(0)
+	{
+	}
+
+	/* methods */
+
+	iterator begin(void)
+	{
+		if ((m_next == m_size) && (m_remaining != 0))
+			Refill();
+
+		return iterator(this);
+	}
+
+	iterator end(void)										{ return iterator(); }
+
+	// copy of this view that ends after count more values
+	RandomView Take(long long count) const
+	{
+		RandomView view(*this);
+
+		if ((view.m_remaining < 0) || (count < view.m_remaining))
+			view.m_remaining = count;
+
+		return view;
+	}
+
+	// pull the next value (generator style), the view must not be done
+	T Next(void)
+	{
+		ASSERT_MSG(!IsDone(), "Random view has yielded every value");
+
+		if (m_next == m_size)
+			Refill();
+
+		T value = m_block[m_next];
+		Advance();
+
+		return value;
+	}
+
+	// true once a limited view has yielded every value
+	bool IsDone(void) const									{ return (m_remaining == 0); }
+
+private:
+
+	/* helper functions */
+
+	const T &Current(void) const							{ return m_block[m_next]; }
+
+	void Advance(void)
+	{
+		++m_next;
+
+		if (m_remaining > 0)
+			--m_remaining;
+
+		if ((m_next == m_size) && (m_remaining != 0))
+			Refill();
+	}
+
+	// draw the next block, never past the limit
+	void Refill(void)
+	{
+		int count = RANDOM_VIEW_BLOCK;
+
+		if ((m_remaining >= 0) && (m_remaining < count))
+			count = static_cast<int>(m_remaining);
+
+		m_fill(*m_random, m_block, count);
+		m_next = 0;
+		m_size = count;
+	}
+
+	/* variables */
+
+	// random number generator to draw from
+	Random *m_random;
+
+	// bulk call of the distribution
+	Fill m_fill;
+
+	// values left to yield (< 0 is unlimited)
+	long long m_remaining;
+
+	// drawn values, m_block[m_next ~ m_size - 1] are not yielded yet
+	T m_block[RANDOM_VIEW_BLOCK];
+	int m_next;
+	int m_size;
+};
+
+/*
+	View applying a function to each value of another view.
+*/
+template <typename View, typename Function>
+class TransformView
+{
+public:
+
+	typedef decltype(std::declval<Function &>()(std::declval<typename View::value_type>())) value_type;
+
+	class iterator
+	{
+	public:
+
+		typedef std::input_iterator_tag iterator_category;
+		typedef typename TransformView::value_type value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const value_type *pointer;
+		typedef value_type reference;
+
+		iterator() : m_function(NULL)						{}
+		iterator(typename View::iterator it, Function *function) : m_it(it), m_function(function) {}
+
+		value_type operator*() const						{ return (*m_function)(*m_it); }
+		iterator &operator++()								{ ++m_it; return *this; }
+		void operator++(int)								{ ++m_it; }
+
+		bool operator==(const iterator &rhs) const			{ return m_it == rhs.m_it; }
+		bool operator!=(const iterator &rhs) const			{ return m_it != rhs.m_it; }
+
+	private:
+
+		typename View::iterator m_it;
+		Function *m_function;
+	};
+
+	/* constructor */
+
+	TransformView(const View &view, const Function &function) : m_view(view), m_function(function)
+	{
+	}
+
+	/* methods */
+
+	iterator begin(void)									{ return iterator(m_view.begin(), &m_function); }
+	iterator end(void)										{ return iterator(m_view.end(), &m_function); }
+
+	// one value in, one value out, so the limit goes to the underlying view
+	TransformView Take(long long count) const				{ return TransformView(m_view.Take(count), m_function); }
+
+	value_type Next(void)									{ return m_function(m_view.Next()); }
+	bool IsDone(void) const									{ return m_view.IsDone(); }
+
+private:
+
+	View m_view;
+	Function m_function;
+};
+
+/* views of each distribution (same values as RangeInt, RangeFloat and NormalRange) */
+
+inline RandomView<int, RandomIntFill> RandomInts(Random &random, int min = DEFAULT_UNI_MIN_I, int max = DEFAULT_UNI_MAX_I)
+{
+	RandomIntFill fill = { min, max };
+	return RandomView<int, RandomIntFill>(random, fill);
+}
+
+inline RandomView<float, RandomFloatFill> RandomFloats(Random &random, float min = DEFAULT_UNI_MIN_F, float max = DEFAULT_UNI_MAX_F)
+{
+	RandomFloatFill fill = { min, max };
+	return RandomView<float, RandomFloatFill>(random, fill);
+}
+
+inline RandomView<float, RandomNormalFill> RandomNormals(Random &random, float mean = DEFAULT_NOR_MEAN, float stddev = DEFAULT_NOR_STDDEV, bool is_clamp = true)
+{
+	RandomNormalFill fill = { mean, stddev, is_clamp };
+	return RandomView<float, RandomNormalFill>(random, fill);
+}
+
+/* adaptors for view | Take(n) | Transform(f) */
+
+struct TakeAdaptor
+{
+	long long count;
+};
+
+template <typename Function>
+struct TransformAdaptor
+{
+	Function function;
+};
+
+inline TakeAdaptor Take(long long count)
+{
+	TakeAdaptor adaptor = { count };
+	return adaptor;
+}
+
+template <typename Function>
+TransformAdaptor<Function> Transform(Function function)
+{
+	TransformAdaptor<Function> adaptor = { function };
+	return adaptor;
+}
+
+template <typename T, typename Fill>
+RandomView<T, Fill> operator|(const RandomView<T, Fill> &view, TakeAdaptor take)
+{
+	return view.Take(take.count);
+}
+
+template <typename View, typename Function>
+TransformView<View, Function> operator|(const TransformView<View, Function> &view, TakeAdaptor take)
+{
+	return view.Take(take.count);
+}
+
+template <typename T, typename Fill, typename Function>
+TransformView<RandomView<T, Fill>, Function> operator|(const RandomView<T, Fill> &view, TransformAdaptor<Function> transform)
+{
+	return TransformView<RandomView<T, Fill>, Function>(view, transform.function);
+}
+
+template <typename View, typename Inner, typename Function>
+TransformView<TransformView<View, Inner>, Function> operator|(const TransformView<View, Inner> &view, TransformAdaptor<Function> transform)
+{
+	return TransformView<TransformView<View, Inner>, Function>(view, transform.function);
+}
@@ -0,0 +1,22 @@
+/******************************************************************************/
+/*!
+\file		SIMD.h
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	SIMD instruction set detection.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+// SSE2 is always available on x64, and on x86 when /arch:SSE2 (the default) is set
+// define RANDOM_NO_SIMD to force the scalar code paths
+
+#if !defined(RANDOM_NO_SIMD) && (defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) || defined(__SSE2__))
+#define RANDOM_USE_SSE2
+#include <emmintrin.h>
+#endif
\ No newline at end of file
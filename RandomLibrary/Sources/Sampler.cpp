@@ -0,0 +1,255 @@
+/******************************************************************************/
+/*!
+\file		Sampler.cpp
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Variance-reduction sampling (antithetic, stratified, Latin hypercube).
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Sampler.h"
+#include "MyAssert.h"
+
+// helper functions
+
+/*--------------------------------------------------------------------------*
+Name:           InStratum
+
+Description:    Keep a sample inside its stratum [lower, upper). RangeFloat()
+				can return exactly 1 and lower + width * u can round up, either
+				would put the sample on the next stratum's lower boundry.
+
+Arguments:      value:		sample.
+				lower:		lower boundry of the stratum.
+				upper:		upper boundry of the stratum.
+
+Returns:        float:		Sample below upper.
+*---------------------------------------------------------------------------*/
+static inline float InStratum(float value, float lower, float upper)
+{
+	return (value < upper) ? value : std::nextafter(upper, lower);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           InRange
+
+Description:    Keep a mirrored sample inside [min, max]. The mirrored sum
+				rounds, e.g. min = 0.1, max = 1e7 gives min + max = 1e7 and
+				a = 1e7 mirrors to 0, below min.
+
+Arguments:      value:		mirrored sample.
+				min:		lower boundry of range.
+				max:		upper boundry of range.
+
+Returns:        float:		Sample clamped to min~max.
+*---------------------------------------------------------------------------*/
+static inline float InRange(float value, float min, float max)
+{
+	return (std::min)((std::max)(value, min), max);
+}
+
+// public functions
+
+/*--------------------------------------------------------------------------*
+Name:           Sampler
+
+Description:    Constructor.
+
+Arguments:      random:	random number generator to draw from.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+Sampler::Sampler(Random &random) : m_random(random)
+{
+}
+
+/*--------------------------------------------------------------------------*
+Name:           ~Sampler
+
+Description:    Destructor.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+Sampler::~Sampler()
+{
+}
+
+/*--------------------------------------------------------------------------*
+Name:           AntitheticFloat
+
+Description:    Returns an antithetic uniform pair. b = min + max - a, so the
+				pair is negatively correlated and the mean of any monotone
+				function of the pair has lower variance than two plain draws.
+				b is clamped to min~max, the mirrored sum can round past either end.
+
+Arguments:      a:		first number of the pair.
+				b:		mirrored number of the pair.
+				min:	lower boundry of range.
+				max:	upper boundry of range.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Sampler::AntitheticFloat(float &a, float &b, float min, float max)
+{
+	a = m_random.RangeFloat(min, max);
+	b = InRange((min + max) - a, min, max);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           AntitheticNormal
+
+Description:    Returns an antithetic normal pair. b = 2 * mean - a.
+				The clamp boundary of NormalRange is symmetric around the mean,
+				but 2 * mean - a rounds, so a clamped b is clamped again to
+				NormalMin~NormalMax.
+
+Arguments:      a:			first number of the pair.
+				b:			mirrored number of the pair.
+				mean:		mean value of normal distribution.
+				stddev:		standard deviation.
+				is_clamp:	flag on if the random number is clamped (3 times stddev).
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Sampler::AntitheticNormal(float &a, float &b, float mean, float stddev, bool is_clamp)
+{
+	a = m_random.NormalRange(mean, stddev, is_clamp);
+	b = (mean + mean) - a;
+
+	if (is_clamp)
+		b = InRange(b, m_random.NormalMin(mean, stddev), m_random.NormalMax(mean, stddev));
+}
+
+/*--------------------------------------------------------------------------*
+Name:           AntitheticFloats
+
+Description:    Fills output with antithetic uniform pairs (a0, b0, a1, b1, ...).
+				An odd count ends with a single plain draw.
+
+Arguments:      output:	buffer of at least count floats.
+				count:	number of values.
+				min:	lower boundry of range.
+				max:	upper boundry of range.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Sampler::AntitheticFloats(float *output, int count, float min, float max)
+{
+	int i = 0;
+
+	for (; i + 2 <= count; i += 2)
+		AntitheticFloat(output[i], output[i + 1], min, max);
+
+	if (i < count)
+		output[i] = m_random.RangeFloat(min, max);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           AntitheticNormals
+
+Description:    Fills output with antithetic normal pairs (a0, b0, a1, b1, ...).
+				An odd count ends with a single plain draw.
+
+Arguments:      output:		buffer of at least count floats.
+				count:		number of values.
+				mean:		mean value of normal distribution.
+				stddev:		standard deviation.
+				is_clamp:	flag on if the random number is clamped (3 times stddev).
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Sampler::AntitheticNormals(float *output, int count, float mean, float stddev, bool is_clamp)
+{
+	int i = 0;
+
+	for (; i + 2 <= count; i += 2)
+		AntitheticNormal(output[i], output[i + 1], mean, stddev, is_clamp);
+
+	if (i < count)
+		output[i] = m_random.NormalRange(mean, stddev, is_clamp);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           StratifiedFloats
+
+Description:    Fills output with uniform numbers spread over equal-width strata.
+				Each stratum receives count / strata numbers, so the sample mean
+				stays unbiased while the variance between strata is removed.
+
+Arguments:      output:	buffer of at least count floats.
+				count:	number of values (multiple of strata).
+				strata:	number of strata.
+				min:	lower boundry of range.
+				max:	upper boundry of range.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Sampler::StratifiedFloats(float *output, int count, int strata, float min, float max)
+{
+	ASSERT_MSG((strata > 0) && (count % strata == 0), "Count should be a multiple of strata");
+
+	int per_stratum = count / strata;
+	float width = (max - min) / static_cast<float>(strata);
+
+	for (int k = 0; k < strata; ++k)
+	{
+		float lower = min + width * static_cast<float>(k);
+		float upper = min + width * static_cast<float>(k + 1);
+
+		for (int i = 0; i < per_stratum; ++i)
+			*output++ = InStratum(lower + width * m_random.RangeFloat(), lower, upper);
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           LatinHypercube
+
+Description:    Fills a Latin hypercube design. Every dimension is split into
+				samples strata and each stratum is hit exactly once; strata are
+				paired across dimensions by independent random permutations.
+
+Arguments:      output:		buffer of at least samples * dimensions floats,
+							point i is output[i * dimensions ~ i * dimensions + dimensions - 1].
+				samples:	number of points.
+				dimensions:	number of dimensions.
+				min:		lower boundry of range (every dimension).
+				max:		upper boundry of range (every dimension).
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void Sampler::LatinHypercube(float *output, int samples, int dimensions, float min, float max)
+{
+	ASSERT_MSG((samples > 0) && (dimensions > 0), "Latin hypercube needs at least one sample and dimension");
+
+	std::vector<int> strata(samples);
+	float width = (max - min) / static_cast<float>(samples);
+
+	for (int d = 0; d < dimensions; ++d)
+	{
+		for (int i = 0; i < samples; ++i)
+			strata[i] = i;
+
+		// Fisher-Yates shuffle
+
+		for (int i = samples - 1; i > 0; --i)
+			std::swap(strata[i], strata[m_random.RangeInt(0, i)]);
+
+		for (int i = 0; i < samples; ++i)
+		{
+			float lower = min + width * static_cast<float>(strata[i]);
+			float upper = min + width * static_cast<float>(strata[i] + 1);
+
+			output[i * dimensions + d] = InStratum(min + width * (static_cast<float>(strata[i]) + m_random.RangeFloat()), lower, upper);
+		}
+	}
+}
\ No newline at end of file
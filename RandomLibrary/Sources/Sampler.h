@@ -0,0 +1,69 @@
+/******************************************************************************/
+/*!
+\file		Sampler.h
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Variance-reduction sampling (antithetic, stratified, Latin hypercube).
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+#include "Random.h"
+
+class Sampler
+{
+public:
+
+	/* constructor/destructor */
+
+	// constructor (the sampler draws from the given generator)
+	Sampler(Random &random);
+
+	// destructor
+	~Sampler();
+
+	/* methods */
+
+	// Returns an antithetic uniform pair, b mirrors a around the middle of min~max (clamped to min~max)
+	void AntitheticFloat(float &a, float &b, float min = DEFAULT_UNI_MIN_F, float max = DEFAULT_UNI_MAX_F);
+
+	// Returns an antithetic normal pair, b mirrors a around the mean
+	// clamping follows NormalRange, the mirrored value is clamped to the same boundary
+	void AntitheticNormal(float &a, float &b,
+		float mean = DEFAULT_NOR_MEAN,
+		float stddev = DEFAULT_NOR_STDDEV,
+		bool is_clamp = true);
+
+	// Fills output with antithetic uniform pairs (a0, b0, a1, b1, ...)
+	// an odd count ends with a single plain draw
+	void AntitheticFloats(float *output, int count, float min = DEFAULT_UNI_MIN_F, float max = DEFAULT_UNI_MAX_F);
+
+	// Fills output with antithetic normal pairs (a0, b0, a1, b1, ...)
+	void AntitheticNormals(float *output, int count,
+		float mean = DEFAULT_NOR_MEAN,
+		float stddev = DEFAULT_NOR_STDDEV,
+		bool is_clamp = true);
+
+	// Fills output with uniform numbers spread over equal-width strata of min~max
+	// count must be a multiple of strata, output is ordered by stratum
+	void StratifiedFloats(float *output, int count, int strata, float min = DEFAULT_UNI_MIN_F, float max = DEFAULT_UNI_MAX_F);
+
+	// Fills a Latin hypercube design of samples points in dimensions dimensions
+	// output[sample * dimensions + dimension], every dimension hits each of the samples strata once
+	void LatinHypercube(float *output, int samples, int dimensions, float min = DEFAULT_UNI_MIN_F, float max = DEFAULT_UNI_MAX_F);
+
+private:
+
+	// no assignment (holds a reference)
+	Sampler &operator=(const Sampler &rhs);
+
+	/* variables */
+
+	// random number generator to draw from
+	Random &m_random;
+};
\ No newline at end of file
@@ -0,0 +1,312 @@
+/******************************************************************************/
+/*!
+\file		StreamAllocator.cpp
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Disjoint random streams of one seed, shared by many processes.
+			Named file mapping of a header with an atomic block counter.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "StreamAllocator.h"
+#include "MyAssert.h"
+
+// static variables
+
+static const unsigned int STREAM_MAGIC = 0x4D525453;		// "STRM"
+static const unsigned int STREAM_VERSION = 1;
+
+// StreamHeader state, the mapping starts zeroed (empty)
+static const LONG STREAM_STATE_EMPTY = 0;
+static const LONG STREAM_STATE_INIT = 1;
+static const LONG STREAM_STATE_READY = 2;
+
+// milliseconds Open waits for another process to set the header ready
+static const DWORD STREAM_OPEN_TIMEOUT = 1000;
+
+// shared segment, written once by the process that creates it except for next_block
+struct StreamHeader
+{
+	volatile LONG state;
+	unsigned int magic;
+	unsigned int version;
+	unsigned int seed;
+	volatile LONGLONG next_block;
+};
+
+// helper functions
+
+/*--------------------------------------------------------------------------*
+Name:           Mix32
+
+Description:    32-bit finalizer (murmur3), a bijection, so distinct inputs
+				never share an output.
+
+Arguments:      value:			value to mix.
+
+Returns:        unsigned int:	Mixed value.
+*---------------------------------------------------------------------------*/
+static inline unsigned int Mix32(unsigned int value)
+{
+	value ^= value >> 16;
+	value *= 0x85EBCA6Bu;
+	value ^= value >> 13;
+	value *= 0xC2B2AE35u;
+	value ^= value >> 16;
+
+	return value;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           ReadState
+
+Description:    Read the header state with a full barrier (the seed written
+				before READY is visible once READY is).
+
+Arguments:      header:		mapped header.
+
+Returns:        LONG:		STREAM_STATE_*.
+*---------------------------------------------------------------------------*/
+static inline LONG ReadState(StreamHeader *header)
+{
+	return InterlockedCompareExchange(&header->state, STREAM_STATE_EMPTY, STREAM_STATE_EMPTY);
+}
+
+// public functions
+
+/*--------------------------------------------------------------------------*
+Name:           StreamAllocator
+
+Description:    Constructor.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+StreamAllocator::StreamAllocator() : m_mapping(NULL), m_header(NULL)
+{
+}
+
+/*--------------------------------------------------------------------------*
+Name:           ~StreamAllocator
+
+Description:    Destructor, closes the segment.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+StreamAllocator::~StreamAllocator()
+{
+	Close();
+}
+
+/*--------------------------------------------------------------------------*
+Name:           GetSeed
+
+Description:    Master seed stored in the segment.
+
+Arguments:      None.
+
+Returns:        unsigned int:	Master seed.
+*---------------------------------------------------------------------------*/
+unsigned int StreamAllocator::GetSeed(void) const
+{
+	ASSERT_MSG(IsOpen(), "Stream allocator is not open");
+
+	return m_header->seed;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           GetClaimed
+
+Description:    Number of blocks claimed so far by every process.
+
+Arguments:      None.
+
+Returns:        unsigned long long:		Number of blocks.
+*---------------------------------------------------------------------------*/
+unsigned long long StreamAllocator::GetClaimed(void) const
+{
+	ASSERT_MSG(IsOpen(), "Stream allocator is not open");
+
+	return static_cast<unsigned long long>(InterlockedExchangeAdd64(&m_header->next_block, 0));
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Open
+
+Description:    Map the named segment. The process that finds it empty
+				stores seed and sets it ready; others wait until it is
+				ready and use the seed stored there. A creator that died
+				before setting it ready leaves it unusable, the wait gives
+				up after STREAM_OPEN_TIMEOUT.
+
+Arguments:      name:		name of the segment.
+				seed:		master seed if this process creates the segment.
+
+Returns:        bool:		True if the segment was opened (false if it was
+							not ready in time).
+*---------------------------------------------------------------------------*/
+bool StreamAllocator::Open(const char *name, unsigned int seed)
+{
+	Close();
+
+	m_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+		0, static_cast<DWORD>(sizeof(StreamHeader)), name);
+
+	if (!m_mapping)
+		return false;
+
+	void *view = MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(StreamHeader));
+
+	if (!view)
+	{
+		Close();
+		return false;
+	}
+
+	m_header = static_cast<StreamHeader *>(view);
+
+	if (InterlockedCompareExchange(&m_header->state, STREAM_STATE_INIT, STREAM_STATE_EMPTY) == STREAM_STATE_EMPTY)
+	{
+		m_header->magic = STREAM_MAGIC;
+		m_header->version = STREAM_VERSION;
+		m_header->seed = seed;
+		m_header->next_block = 0;
+
+		InterlockedExchange(&m_header->state, STREAM_STATE_READY);
+	}
+	else
+	{
+		// another process is writing the header, only takes a few instructions
+
+		DWORD start = GetTickCount();
+
+		while (ReadState(m_header) != STREAM_STATE_READY)
+		{
+			if (GetTickCount() - start > STREAM_OPEN_TIMEOUT)
+			{
+				Close();
+				return false;
+			}
+
+			Sleep(0);
+		}
+
+		if ((m_header->magic != STREAM_MAGIC) || (m_header->version != STREAM_VERSION))
+		{
+			Close();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Close
+
+Description:    Unmap the segment.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void StreamAllocator::Close(void)
+{
+	if (m_header)
+	{
+		UnmapViewOfFile(m_header);
+		m_header = NULL;
+	}
+
+	if (m_mapping)
+	{
+		CloseHandle(m_mapping);
+		m_mapping = NULL;
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Claim
+
+Description:    Claim blocks no other caller (in any process) gets, lock-free.
+
+Arguments:      count:					number of blocks.
+
+Returns:        unsigned long long:		First block claimed.
+*---------------------------------------------------------------------------*/
+unsigned long long StreamAllocator::Claim(int count)
+{
+	ASSERT_MSG(IsOpen(), "Stream allocator is not open");
+	ASSERT_MSG(count > 0, "Block count should be > 0");
+
+	unsigned long long first = static_cast<unsigned long long>(InterlockedExchangeAdd64(&m_header->next_block, count));
+
+	// BlockSeed repeats from block 2^32 on
+	ASSERT_MSG(first + count <= 0x100000000ull, "Stream allocator is out of blocks");
+
+	return first;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           BlockSeed
+
+Description:    Seed of a block. Blocks are spread over the seeds by a
+				bijection, so the first 2^32 blocks all get different seeds.
+
+Arguments:      block:			block number.
+
+Returns:        unsigned int:	Seed of the block.
+*---------------------------------------------------------------------------*/
+unsigned int StreamAllocator::BlockSeed(unsigned long long block) const
+{
+	ASSERT_MSG(IsOpen(), "Stream allocator is not open");
+
+	return Mix32(m_header->seed + static_cast<unsigned int>(block) * 0x9E3779B9u);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Seed
+
+Description:    Claim a block and reseed random with it.
+
+Arguments:      random:					generator to reseed.
+
+Returns:        unsigned long long:		Block claimed.
+*---------------------------------------------------------------------------*/
+unsigned long long StreamAllocator::Seed(Random &random)
+{
+	unsigned long long block = Claim();
+
+	random.SetSeed(BlockSeed(block));
+
+	return block;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Seed
+
+Description:    Claim a block and give every entity of array block b of its
+				stream: seeded with the master seed and jumped b * 2^64
+				draws, so the blocks of an entity never overlap (within
+				2^64 draws each).
+
+Arguments:      array:					generators to reseed.
+
+Returns:        unsigned long long:		Block claimed.
+*---------------------------------------------------------------------------*/
+unsigned long long StreamAllocator::Seed(RandomArray &array)
+{
+	unsigned long long block = Claim();
+
+	array.SetSeed(GetSeed());
+	array.Jump(block);
+
+	return block;
+}
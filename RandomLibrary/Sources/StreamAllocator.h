@@ -0,0 +1,100 @@
+/******************************************************************************/
+/*!
+\file		StreamAllocator.h
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Random streams of one seed, shared by many processes.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+#include "Random.h"
+#include "RandomArray.h"
+
+struct StreamHeader;
+
+/*
+	Every process that opens the same name maps one small named shared
+	memory segment holding the master seed and a block counter. The first
+	process to open it stores its seed, the others use that one.
+
+	Claim takes the next block numbers with a single atomic add, so no locks
+	are taken and no process waits on another. Draws never touch the
+	segment; a generator that has used up its block (however the caller
+	counts) just calls Seed again.
+
+	A RandomArray gets disjoint streams: block b seeds every entity with the
+	master seed and jumps it b * 2^64 draws ahead (RandomArray::Jump), so
+	the blocks of an entity never overlap unless one draws 2^64 numbers.
+
+	A Random has no jump-ahead (std::default_random_engine), block b only
+	seeds it with BlockSeed(b), which is different for each of the first
+	2^32 blocks of a master seed (Claim asserts past that). Distinct seeds
+	are not disjoint streams, each seed only starts the engine somewhere
+	else on its cycle. On a short-period engine such as minstd_rand0 every
+	seed is an offset on the same 2^31 cycle, so two blocks can overlap
+	once a block draws about 2^31 / (number of blocks) numbers, and for a
+	few blocks even sooner by chance (seeds equal modulo 2^31 - 1 even give
+	the same stream). Keep such blocks short (reseed often) or use a
+	RandomArray.
+*/
+class StreamAllocator
+{
+public:
+
+	/* constructor/destructor */
+
+	// constructor (not open)
+	StreamAllocator();
+
+	// destructor (closes the segment)
+	~StreamAllocator();
+
+	/* getter/setter */
+
+	bool IsOpen(void) const									{ return (m_header != NULL); }
+
+	// master seed stored in the segment
+	unsigned int GetSeed(void) const;
+
+	// number of blocks claimed so far by every process
+	unsigned long long GetClaimed(void) const;
+
+	/* methods */
+
+	// open the segment name (e.g. "Local\\MyExperiment"), created with seed if no process has it open
+	// false if it cannot be mapped or its creator never set it up (died in between, waits up to a second)
+	bool Open(const char *name, unsigned int seed);
+
+	// unmap the segment (it is freed when the last process closes it)
+	void Close(void);
+
+	// claim count blocks, returns the first (the blocks are first ~ first + count - 1)
+	unsigned long long Claim(int count = 1);
+
+	// seed of a block
+	unsigned int BlockSeed(unsigned long long block) const;
+
+	// claim a block and reseed random with its seed, returns the block
+	unsigned long long Seed(Random &random);
+
+	// claim a block and jump every entity of array to it, returns the block
+	unsigned long long Seed(RandomArray &array);
+
+private:
+
+	// not copyable (owns the mapping)
+	StreamAllocator(const StreamAllocator &rhs);
+	StreamAllocator &operator=(const StreamAllocator &rhs);
+
+	/* variables */
+
+	// mapping handle and the mapped segment
+	void *m_mapping;
+	StreamHeader *m_header;
+};
@@ -0,0 +1,333 @@
+/******************************************************************************/
+/*!
+\file		WeightedSampler.cpp
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Weighted random selection with weights that change every frame.
+			Flat Fenwick tree of the weights over a power of 2 items,
+			so the total is the last node and the descent needs no bounds checks.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "WeightedSampler.h"
+#include "MyAssert.h"
+
+// helper functions
+
+// lowest set bit
+static inline int LowBit(int value)		{ return value & (-value); }
+
+/*--------------------------------------------------------------------------*
+Name:           UniformDouble
+
+Description:    Uniform double [0, 1) from 32 random bits. A float from
+				RangeFloat has only 24, too few to reach light items of a big set.
+
+Arguments:      bits:		random word.
+
+Returns:        double:		Random number [0, 1).
+*---------------------------------------------------------------------------*/
+static inline double UniformDouble(unsigned int bits)
+{
+	return static_cast<double>(bits) * (1.0 / 4294967296.0);
+}
+
+// public functions
+
+/*--------------------------------------------------------------------------*
+Name:           WeightedSampler
+
+Description:    Constructor.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+WeightedSampler::WeightedSampler() : m_tree(1, 0.0), m_span(0)
+{
+}
+
+/*--------------------------------------------------------------------------*
+Name:           ~WeightedSampler
+
+Description:    Destructor.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+WeightedSampler::~WeightedSampler()
+{
+}
+
+/*--------------------------------------------------------------------------*
+Name:           SetWeight
+
+Description:    Change the weight of an item (not a removed one).
+
+Arguments:      index:		item index.
+				weight:		new weight (>= 0).
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void WeightedSampler::SetWeight(int index, double weight)
+{
+	ASSERT_MSG((index >= 0) && (index < GetCapacity()), "Weighted sampler index is out of range");
+	ASSERT_MSG(!m_is_free[index], "Weighted sampler item is removed");
+	ASSERT_MSG(weight >= 0.0, "Weight should be >= 0");
+
+	double delta = weight - m_weights[index];
+
+	m_weights[index] = weight;
+
+	for (int i = index + 1; i <= m_span; i += LowBit(i))
+		m_tree[i] += delta;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           GetTotal
+
+Description:    Sum of every weight.
+
+Arguments:      None.
+
+Returns:        double:		Total weight.
+*---------------------------------------------------------------------------*/
+double WeightedSampler::GetTotal(void) const
+{
+	return m_tree[m_span];
+}
+
+/*--------------------------------------------------------------------------*
+Name:           GetCount
+
+Description:    Number of items, removed ones are not counted.
+
+Arguments:      None.
+
+Returns:        int:		Number of items.
+*---------------------------------------------------------------------------*/
+int WeightedSampler::GetCount(void) const
+{
+	return GetCapacity() - static_cast<int>(m_free.size());
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Insert
+
+Description:    Add an item, reusing a removed index when there is one.
+
+Arguments:      weight:		weight of the item (>= 0).
+
+Returns:        int:		Index of the item.
+*---------------------------------------------------------------------------*/
+int WeightedSampler::Insert(double weight)
+{
+	ASSERT_MSG(weight >= 0.0, "Weight should be >= 0");
+
+	if (!m_free.empty())
+	{
+		int index = m_free.back();
+		m_free.pop_back();
+		m_is_free[index] = false;
+
+		SetWeight(index, weight);
+
+		return index;
+	}
+
+	int index = GetCapacity();
+
+	m_weights.push_back(0.0);
+	m_is_free.push_back(false);
+
+	// the tree is full, double it (amortized O(1) per insert)
+
+	if (index == m_span)
+	{
+		m_span = (m_span == 0) ? 1 : (m_span * 2);
+		m_tree.assign(m_span + 1, 0.0);
+		Rebuild();
+	}
+
+	SetWeight(index, weight);
+
+	return index;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Remove
+
+Description:    Remove an item, which must not be removed already
+				(its index would be handed out twice by later inserts).
+
+Arguments:      index:		item index.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void WeightedSampler::Remove(int index)
+{
+	ASSERT_MSG((index >= 0) && (index < GetCapacity()), "Weighted sampler index is out of range");
+	ASSERT_MSG(!m_is_free[index], "Weighted sampler item is removed already");
+
+	SetWeight(index, 0.0);
+	m_is_free[index] = true;
+	m_free.push_back(index);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Clear
+
+Description:    Remove every item (memory is kept).
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void WeightedSampler::Clear(void)
+{
+	m_weights.clear();
+	m_is_free.clear();
+	m_tree.assign(1, 0.0);
+	m_free.clear();
+	m_span = 0;
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Reserve
+
+Description:    Make room for capacity items without reallocating.
+
+Arguments:      capacity:	number of items.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void WeightedSampler::Reserve(int capacity)
+{
+	int span = 1;
+
+	while (span < capacity)
+		span *= 2;
+
+	m_weights.reserve(capacity);
+	m_is_free.reserve(capacity);
+	m_tree.reserve(span + 1);
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Rebuild
+
+Description:    Recompute the tree from the weights in O(n).
+				Every update adds its rounding error to the tree, call this
+				once in a while if weights change by huge amounts.
+
+Arguments:      None.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void WeightedSampler::Rebuild(void)
+{
+	int size = GetCapacity();
+
+	for (int i = 1; i <= m_span; ++i)
+		m_tree[i] = (i <= size) ? m_weights[i - 1] : 0.0;
+
+	for (int i = 1; i <= m_span; ++i)
+	{
+		int parent = i + LowBit(i);
+
+		if (parent <= m_span)
+			m_tree[parent] += m_tree[i];
+	}
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Sample
+
+Description:    Returns the index of a random item, chosen with probability weight / total.
+
+Arguments:      random:		random number generator to draw from.
+
+Returns:        int:		Item index.
+*---------------------------------------------------------------------------*/
+int WeightedSampler::Sample(Random &random) const
+{
+	return Find(UniformDouble(random.RawBits()) * GetTotal());
+}
+
+/*--------------------------------------------------------------------------*
+Name:           Fill
+
+Description:    Fills output with count random item indices.
+				Produces the same sequence as calling Sample count times.
+
+Arguments:      random:		random number generator to draw from.
+				output:		buffer of at least count indices.
+				count:		number of indices.
+
+Returns:        None.
+*---------------------------------------------------------------------------*/
+void WeightedSampler::Fill(Random &random, int *output, int count) const
+{
+	// random words are drawn a block at a time
+
+	static const int BLOCK = 256;
+
+	unsigned int bits[BLOCK];
+	double total = GetTotal();
+
+	for (int i = 0; i < count; i += BLOCK)
+	{
+		int block = (count - i < BLOCK) ? (count - i) : BLOCK;
+
+		random.FillRawBits(bits, block);
+
+		for (int j = 0; j < block; ++j)
+			output[i + j] = Find(UniformDouble(bits[j]) * total);
+	}
+}
+
+// private functions
+
+/*--------------------------------------------------------------------------*
+Name:           Find
+
+Description:    Item whose cumulative weight range holds target, by descending
+				the tree from the root. Written with selects instead of branches,
+				which direction the descent takes is random.
+
+Arguments:      target:		cumulative weight [0, total).
+
+Returns:        int:		Item index.
+*---------------------------------------------------------------------------*/
+int WeightedSampler::Find(double target) const
+{
+	ASSERT_MSG(GetCapacity() > 0, "Weighted sampler is empty");
+
+	int size = GetCapacity();
+	int position = 0;
+
+	for (int step = m_span; step > 0; step >>= 1)
+	{
+		int next = position + step;
+		double value = m_tree[next];
+		bool is_right = (value <= target);
+
+		position = is_right ? next : position;
+		target -= is_right ? value : 0.0;
+	}
+
+	// rounding can step past the last item with weight, walk back to it
+
+	if (position >= size)
+		position = size - 1;
+
+	while ((position > 0) && (m_weights[position] <= 0.0))
+		--position;
+
+	return position;
+}
@@ -0,0 +1,103 @@
+/******************************************************************************/
+/*!
+\file		WeightedSampler.h
+\project	AI Framework
+\author		Chi-Hao Kuo
+\summary	Weighted random selection with weights that change every frame.
+
+Copyright (C) 2016 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "Random.h"
+
+/*
+	Weights are kept in a Fenwick (binary indexed) tree stored as one flat
+	array, so update, remove and sample are O(log n) and insert is amortized
+	O(log n) (the array doubles when full), with no per-item allocation.
+
+	Items are referred to by the index returned from Insert. Removed indices
+	are reused by later inserts, other indices never move.
+*/
+class WeightedSampler
+{
+public:
+
+	/* constructor/destructor */
+
+	// constructor (no items)
+	WeightedSampler();
+
+	// destructor
+	~WeightedSampler();
+
+	/* getter/setter */
+
+	// weight of an item (0 if removed)
+	double GetWeight(int index) const						{ return m_weights[index]; }
+	void SetWeight(int index, double weight);
+
+	// sum of every weight (O(1))
+	double GetTotal(void) const;
+
+	// number of items (not counting removed ones)
+	int GetCount(void) const;
+
+	// size of the index range (removed items included)
+	int GetCapacity(void) const								{ return static_cast<int>(m_weights.size()); }
+
+	/* methods */
+
+	// add an item, returns its index
+	int Insert(double weight);
+
+	// remove an item (once), its index may be returned by a later Insert
+	void Remove(int index);
+
+	// remove every item
+	void Clear(void);
+
+	// make room for capacity items without reallocating
+	void Reserve(int capacity);
+
+	// recompute the tree from the weights (drops rounding error of many updates)
+	void Rebuild(void);
+
+	// Returns the index of a random item, chosen with probability weight / total
+	// total must be more than 0
+	int Sample(Random &random) const;
+
+	// Fills output with count random item indices, same sequence as calling Sample count times
+	void Fill(Random &random, int *output, int count) const;
+
+private:
+
+	/* helper functions */
+
+	// item holding cumulative weight target
+	int Find(double target) const;
+
+	/* variables */
+
+	// weight of each item
+	std::vector<double> m_weights;
+
+	// Fenwick tree of m_span items, m_tree[i] is the sum of items (i - lowbit(i)) ~ (i - 1)
+	// m_tree[0] is unused and m_tree[m_span] is the total
+	std::vector<double> m_tree;
+
+	// removed indices to reuse
+	std::vector<int> m_free;
+
+	// whether each index is in m_free (catches removing or updating a removed item)
+	std::vector<bool> m_is_free;
+
+	// items covered by the tree, power of 2 >= capacity (items past capacity weigh 0)
+	int m_span;
+};